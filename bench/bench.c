@@ -0,0 +1,504 @@
+// Headless engine benchmarks, built against the null backend.
+//
+//   zig build bench -Doptimize=ReleaseFast -- [--json PATH] [--filter NAME] [--min-time SECONDS]
+//                                             [--simd scalar|sse2|avx2|avx512|neon]
+//
+// Each case runs repeatedly for at least --min-time and reports nanoseconds
+// per operation. Results and tagged memory stats are written as JSON to
+// stdout or PATH; a readable summary goes to stderr. On Linux, data TLB
+// misses per operation are read from perf_event when the kernel allows it
+// (kernel.perf_event_paranoid <= 2). --simd forces a kernel variant instead
+// of the best one the CPU supports, to compare them.
+
+#if defined(__linux__)
+#define _GNU_SOURCE  // syscall under -std=c99
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define BENCH_PERF_EVENTS 1
+#endif
+
+#include "../src/engine/animation.h"
+#include "../src/engine/arena.h"
+#include "../src/engine/graphics.h"
+#include "../src/engine/hashmap.h"
+#include "../src/engine/intern.h"
+#include "../src/engine/mem.h"
+#include "../src/engine/simd.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_MAX_CASES 16
+
+typedef struct {
+    const char* name;
+    const char* unit;  // what one operation is
+    int ops;           // operations per call of run
+    void (*setup)(void);
+    void (*run)(void);
+    void (*teardown)(void);
+} BenchCase;
+
+typedef struct {
+    const BenchCase* bench;
+    long long iterations;
+    double ns_per_op;
+    unsigned int allocs_per_iteration;  // steady state, should stay 0
+    double dtlb_misses_per_op;          // negative when counters are unavailable
+} BenchResult;
+
+// Cheap deterministic values so runs are comparable
+static unsigned int bench_seed = 12345u;
+
+static unsigned int bench_rand(void) {
+    bench_seed ^= bench_seed << 13;
+    bench_seed ^= bench_seed >> 17;
+    bench_seed ^= bench_seed << 5;
+    return bench_seed;
+}
+
+static float bench_randf(float range) {
+    return (float)(bench_rand() & 0xFFFF) / 65535.0f * range;
+}
+
+// Results go here so the compiler can't drop the work
+static volatile uint32_t bench_sink;
+
+// Rectangles through the shared batch, one frame of 2000
+#define RECTS_PER_FRAME 2000
+
+static void run_rects(void) {
+    graphics_begin_frame();
+    for (int i = 0; i < RECTS_PER_FRAME; i++) {
+        GfxRectangle rect = {(float)(i % 80) * 10.0f, (float)(i / 80) * 18.0f, 8.0f, 16.0f};
+        graphics_draw_rectangle(rect, (GfxColor){(unsigned char)i, 128, 64, 255});
+    }
+    graphics_end_frame();
+}
+
+// Same frame under a scrolling, zoomed view
+static void run_rects_view(void) {
+    graphics_begin_frame();
+    graphics_set_view(123.0f, 45.0f, 1.5f);
+    for (int i = 0; i < RECTS_PER_FRAME; i++) {
+        GfxRectangle rect = {(float)(i % 80) * 10.0f, (float)(i / 80) * 18.0f, 8.0f, 16.0f};
+        graphics_draw_rectangle(rect, (GfxColor){(unsigned char)i, 128, 64, 255});
+    }
+    graphics_reset_view();
+    graphics_end_frame();
+}
+
+// graphics_should_close straight through to the null backend's, which
+// does nothing: what is left is the cost of the wrapper call itself, the
+// overhead the unity build (-Dunity=true) inlines away
+#define WRAPPER_CALLS 100000
+
+static void run_wrapper_calls(void) {
+    int open = 0;
+    for (int i = 0; i < WRAPPER_CALLS; i++) {
+        open += !graphics_should_close();
+    }
+    bench_sink = (uint32_t)open;
+}
+
+#define PRIMITIVES_PER_FRAME 500
+
+static void run_primitives(void) {
+    graphics_begin_frame();
+    for (int i = 0; i < PRIMITIVES_PER_FRAME; i++) {
+        float x = (float)(i % 40) * 20.0f;
+        float y = (float)(i / 40) * 36.0f;
+        graphics_draw_circle(x, y, 8.0f + (float)(i & 7), COLOR_WHITE);
+        graphics_draw_line(x, y, x + 15.0f, y + 30.0f, 2.0f, COLOR_RED);
+    }
+    graphics_end_frame();
+}
+
+// Animator update over the full animator table
+static int bench_animators[ANIMATION_MAX_ANIMATORS];
+
+static void setup_animation(void) {
+    AnimationFrameDesc frames[8];
+    for (int i = 0; i < 8; i++) {
+        frames[i] = (AnimationFrameDesc){{(float)i * 32.0f, 0.0f, 32.0f, 32.0f}, 0.05f + 0.01f * (float)i};
+    }
+    int clip = animation_clip_compile(frames, 8, 256, 32, true);
+    for (int i = 0; i < ANIMATION_MAX_ANIMATORS; i++) {
+        bench_animators[i] = animation_animator_create(clip);
+        animation_set_speed(bench_animators[i], 0.5f + bench_randf(1.5f));
+    }
+}
+
+static void run_animation(void) {
+    animation_update(1.0f / 60.0f);
+}
+
+static void teardown_animation(void) {
+    for (int i = 0; i < ANIMATION_MAX_ANIMATORS; i++) {
+        animation_animator_destroy(bench_animators[i]);
+    }
+}
+
+// View transform kernel over a batch-sized vertex buffer
+#define TRANSFORM_VERTICES 4096
+
+static GfxVertex bench_vertices[TRANSFORM_VERTICES];
+
+static void setup_transform(void) {
+    for (int i = 0; i < TRANSFORM_VERTICES; i++) {
+        bench_vertices[i] = (GfxVertex){bench_randf(800.0f), bench_randf(450.0f), 0.0f, 1.0f, COLOR_WHITE};
+    }
+}
+
+// Scale 1 and bias 0 keep the values stable over millions of runs
+static void run_transform(void) {
+    simd_transform_vertices(bench_vertices, TRANSFORM_VERTICES, 1.0f, 0.0f, 0.0f);
+}
+
+// Hash map lookups at 50% load, half hits and half misses
+#define HASHMAP_KEYS 16384
+
+static Arena bench_arena;
+static HashMap bench_map;
+static uint64_t bench_keys[HASHMAP_KEYS * 2];
+
+static void setup_hashmap(void) {
+    arena_init(&bench_arena, 4u << 20, MEM_TAG_GAMEPLAY);
+    hashmap_init(&bench_map, &bench_arena, HASHMAP_KEYS * 2);
+    for (int i = 0; i < HASHMAP_KEYS * 2; i++) {
+        bench_keys[i] = ((uint64_t)bench_rand() << 32) | bench_rand();
+    }
+    for (int i = 0; i < HASHMAP_KEYS; i++) {
+        hashmap_put(&bench_map, bench_keys[i * 2], (uint32_t)i);
+    }
+}
+
+static void run_hashmap(void) {
+    uint32_t sum = 0;
+    for (int i = 0; i < HASHMAP_KEYS * 2; i++) {
+        uint32_t value = 0;
+        if (hashmap_get(&bench_map, bench_keys[i], &value)) {
+            sum += value;
+        }
+    }
+    bench_sink = sum;
+}
+
+// Remove one key and insert a fresh one, at 50% load. Tombstones build up
+// past the 7/8 limit over and over, so in-place rehashes are part of the cost.
+static uint64_t churn_next_key;
+
+static void setup_hashmap_churn(void) {
+    arena_init(&bench_arena, 4u << 20, MEM_TAG_GAMEPLAY);
+    hashmap_init(&bench_map, &bench_arena, HASHMAP_KEYS * 2);
+    for (int i = 0; i < HASHMAP_KEYS; i++) {
+        bench_keys[i] = ++churn_next_key;
+        hashmap_put(&bench_map, bench_keys[i], (uint32_t)i);
+    }
+}
+
+static void run_hashmap_churn(void) {
+    for (int i = 0; i < HASHMAP_KEYS; i++) {
+        hashmap_remove(&bench_map, bench_keys[i]);
+        bench_keys[i] = ++churn_next_key;
+        if (!hashmap_put(&bench_map, bench_keys[i], (uint32_t)i)) {
+            fprintf(stderr, "hashmap_churn: put failed with %u live keys, %u tombstones\n", bench_map.count,
+                    bench_map.tombstones);
+            exit(1);
+        }
+    }
+}
+
+static void teardown_arena(void) {
+    arena_destroy(&bench_arena);
+}
+
+// Interning names that already exist, the common case at runtime
+#define INTERN_STRINGS 1024
+
+static StringInterner bench_interner;
+static char bench_strings[INTERN_STRINGS][24];
+static int bench_string_lengths[INTERN_STRINGS];
+
+static void setup_intern(void) {
+    arena_init(&bench_arena, 1u << 20, MEM_TAG_ASSETS);
+    interner_init(&bench_interner, &bench_arena, INTERN_STRINGS);
+    for (int i = 0; i < INTERN_STRINGS; i++) {
+        bench_string_lengths[i] = snprintf(bench_strings[i], sizeof(bench_strings[i]), "sprites/obstacle_%d", i);
+        interner_intern(&bench_interner, bench_strings[i], bench_string_lengths[i]);
+    }
+}
+
+static void run_intern(void) {
+    uint32_t sum = 0;
+    for (int i = 0; i < INTERN_STRINGS; i++) {
+        sum += interner_intern(&bench_interner, bench_strings[i], bench_string_lengths[i]);
+    }
+    bench_sink = sum;
+}
+
+// Random reads over a 64 MB arena, with 4 KB pages and then huge pages.
+// The gap between the two is what the TLB costs.
+#define LARGE_ARENA_SIZE ((size_t)64 << 20)
+#define LARGE_ARENA_READS 65536
+
+static Arena large_arena;
+static unsigned char* large_block;
+
+static void fill_large_arena(void) {
+    large_block = arena_alloc(&large_arena, LARGE_ARENA_SIZE, ARENA_DEFAULT_ALIGN);
+    if (large_block == NULL) {
+        fprintf(stderr, "large arena allocation failed\n");
+        exit(1);
+    }
+    // Fault every page in up front so the timed loop only sees TLB misses
+    memset(large_block, 1, LARGE_ARENA_SIZE);
+}
+
+// With THP set to "always" a plain 64 MB malloc gets huge pages too, so
+// the baseline opts out explicitly before any page is touched
+static void setup_large_arena(void) {
+    arena_init(&large_arena, LARGE_ARENA_SIZE, MEM_TAG_GAMEPLAY);
+#if defined(BENCH_PERF_EVENTS) && defined(MADV_NOHUGEPAGE)
+    uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start = ((uintptr_t)large_arena.base + page - 1) & ~(page - 1);
+    uintptr_t end = ((uintptr_t)large_arena.base + large_arena.capacity) & ~(page - 1);
+    if (madvise((void*)start, end - start, MADV_NOHUGEPAGE) != 0) {
+        fprintf(stderr, "large arena: MADV_NOHUGEPAGE failed, the 4k baseline may use huge pages\n");
+    }
+#endif
+    fill_large_arena();
+}
+
+static void setup_large_arena_huge(void) {
+    static const char* backing_names[] = {"heap", "hugetlb", "thp"};
+    arena_init_large(&large_arena, LARGE_ARENA_SIZE, MEM_TAG_GAMEPLAY);
+    fprintf(stderr, "large arena backing: %s\n", backing_names[large_arena.backing]);
+    fill_large_arena();
+}
+
+static void run_large_arena(void) {
+    unsigned int x = bench_seed;
+    uint32_t sum = 0;
+    for (int i = 0; i < LARGE_ARENA_READS; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        sum += large_block[(x * 64u) & (LARGE_ARENA_SIZE - 1)];
+    }
+    bench_seed = x;
+    bench_sink = sum;
+}
+
+static void teardown_large_arena(void) {
+    arena_destroy(&large_arena);
+}
+
+static const BenchCase bench_cases[] = {
+    {"rects", "rect", RECTS_PER_FRAME, NULL, run_rects, NULL},
+    {"rects_view", "rect", RECTS_PER_FRAME, NULL, run_rects_view, NULL},
+    {"wrapper_calls", "call", WRAPPER_CALLS, NULL, run_wrapper_calls, NULL},
+    {"primitives", "shape", PRIMITIVES_PER_FRAME * 2, NULL, run_primitives, NULL},
+    {"transform_vertices", "vertex", TRANSFORM_VERTICES, setup_transform, run_transform, NULL},
+    {"animation_update", "animator", ANIMATION_MAX_ANIMATORS, setup_animation, run_animation, teardown_animation},
+    {"hashmap_get", "lookup", HASHMAP_KEYS * 2, setup_hashmap, run_hashmap, teardown_arena},
+    {"hashmap_churn", "remove+put", HASHMAP_KEYS, setup_hashmap_churn, run_hashmap_churn, teardown_arena},
+    {"intern_existing", "string", INTERN_STRINGS, setup_intern, run_intern, teardown_arena},
+    {"large_arena_4k", "read", LARGE_ARENA_READS, setup_large_arena, run_large_arena, teardown_large_arena},
+    {"large_arena_huge", "read", LARGE_ARENA_READS, setup_large_arena_huge, run_large_arena, teardown_large_arena},
+};
+
+#define BENCH_CASE_COUNT ((int)(sizeof(bench_cases) / sizeof(bench_cases[0])))
+
+// Data TLB read misses for this process, user space only. -1 if the kernel
+// or the CPU doesn't provide the counter; perf_status says why.
+static int perf_fd = -1;
+static char perf_status[96] = "unavailable (no perf_event on this platform)";
+
+static void perf_counter_open(void) {
+#ifdef BENCH_PERF_EVENTS
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    perf_fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (perf_fd >= 0) {
+        snprintf(perf_status, sizeof(perf_status), "available");
+    } else {
+        snprintf(perf_status, sizeof(perf_status), "unavailable (%s)", strerror(errno));
+    }
+#endif
+    fprintf(stderr, "dTLB counter: %s\n", perf_status);
+}
+
+static void perf_counter_start(void) {
+#ifdef BENCH_PERF_EVENTS
+    if (perf_fd >= 0) {
+        ioctl(perf_fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(perf_fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+static long long perf_counter_stop(void) {
+#ifdef BENCH_PERF_EVENTS
+    long long count = 0;
+    if (perf_fd >= 0) {
+        ioctl(perf_fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(perf_fd, &count, sizeof(count)) == (ssize_t)sizeof(count)) {
+            return count;
+        }
+    }
+#endif
+    return -1;
+}
+
+static void perf_counter_close(void) {
+#ifdef BENCH_PERF_EVENTS
+    if (perf_fd >= 0) {
+        close(perf_fd);
+        perf_fd = -1;
+    }
+#endif
+}
+
+static BenchResult bench_run(const BenchCase* bench, double min_time) {
+    BenchResult result = {bench, 0, 0.0, 0, -1.0};
+    if (bench->setup) {
+        bench->setup();
+    }
+    // Warm up caches and lazily built tables
+    for (int i = 0; i < 3; i++) {
+        bench->run();
+    }
+    mem_end_frame();
+
+    double start = graphics_get_time();
+    double elapsed = 0.0;
+    perf_counter_start();
+    while (elapsed < min_time) {
+        bench->run();
+        mem_end_frame();
+        result.iterations++;
+        elapsed = graphics_get_time() - start;
+    }
+    long long dtlb_misses = perf_counter_stop();
+    double ops = (double)result.iterations * (double)bench->ops;
+    result.ns_per_op = elapsed * 1e9 / ops;
+    if (dtlb_misses >= 0) {
+        result.dtlb_misses_per_op = (double)dtlb_misses / ops;
+    }
+    result.allocs_per_iteration = mem_get_total().frame_allocs;
+
+    if (bench->teardown) {
+        bench->teardown();
+    }
+    return result;
+}
+
+static void write_json(FILE* out, const BenchResult* results, int count) {
+    fprintf(out, "{\n  \"simd\": \"%s\",\n  \"dtlb_counter\": \"%s\",\n  \"benchmarks\": [\n",
+            simd_level_name(simd_active_level()), perf_status);
+    for (int i = 0; i < count; i++) {
+        const BenchResult* r = &results[i];
+        char dtlb[32] = "null";
+        if (r->dtlb_misses_per_op >= 0.0) {
+            snprintf(dtlb, sizeof(dtlb), "%.4f", r->dtlb_misses_per_op);
+        }
+        fprintf(out,
+                "    {\"name\": \"%s\", \"unit\": \"%s\", \"iterations\": %lld, \"ns_per_op\": %.3f, "
+                "\"allocs_per_iteration\": %u, \"dtlb_misses_per_op\": %s}%s\n",
+                r->bench->name, r->bench->unit, r->iterations, r->ns_per_op, r->allocs_per_iteration, dtlb,
+                i + 1 < count ? "," : "");
+    }
+    fprintf(out, "  ],\n  \"memory\": {\n");
+    for (int i = 0; i < MEM_TAG_COUNT; i++) {
+        MemTagStats stats = mem_get_stats((MemTag)i);
+        fprintf(out, "    \"%s\": {\"live_bytes\": %zu, \"peak_bytes\": %zu, \"total_allocs\": %u},\n",
+                mem_tag_name((MemTag)i), stats.live_bytes, stats.peak_bytes, stats.total_allocs);
+    }
+    MemTagStats total = mem_get_total();
+    fprintf(out, "    \"total\": {\"live_bytes\": %zu, \"peak_bytes\": %zu, \"total_allocs\": %u}\n  }\n}\n",
+            total.live_bytes, total.peak_bytes, total.total_allocs);
+}
+
+static void usage(void) {
+    fprintf(stderr, "usage: bench [--json PATH] [--filter NAME] [--min-time SECONDS] [--simd LEVEL]\n");
+}
+
+int main(int argc, char** argv) {
+    const char* json_path = NULL;
+    const char* filter = NULL;
+    double min_time = 0.5;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            min_time = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--simd") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            if (!simd_force_level(simd_level_from_name(name))) {
+                fprintf(stderr, "SIMD level %s is not supported here (best: %s)\n", name,
+                        simd_level_name(simd_best_level()));
+                return 1;
+            }
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    graphics_init(800, 450, "bench", GRAPHICS_NULL);
+    perf_counter_open();
+    fprintf(stderr, "simd: %s\n", simd_level_name(simd_active_level()));
+
+    BenchResult results[BENCH_MAX_CASES];
+    int result_count = 0;
+    for (int i = 0; i < BENCH_CASE_COUNT && result_count < BENCH_MAX_CASES; i++) {
+        if (filter && strstr(bench_cases[i].name, filter) == NULL) {
+            continue;
+        }
+        results[result_count] = bench_run(&bench_cases[i], min_time);
+        const BenchResult* r = &results[result_count];
+        fprintf(stderr, "%-18s %10.2f ns/%s  (%lld iterations, %u allocs/iteration", bench_cases[i].name,
+                r->ns_per_op, bench_cases[i].unit, r->iterations, r->allocs_per_iteration);
+        if (r->dtlb_misses_per_op >= 0.0) {
+            fprintf(stderr, ", %.4f dTLB misses/%s", r->dtlb_misses_per_op, bench_cases[i].unit);
+        } else {
+            fprintf(stderr, ", dTLB misses n/a");
+        }
+        fprintf(stderr, ")\n");
+        result_count++;
+    }
+
+    FILE* out = stdout;
+    if (json_path) {
+        out = fopen(json_path, "w");
+        if (out == NULL) {
+            fprintf(stderr, "Could not open %s\n", json_path);
+            perf_counter_close();
+            graphics_shutdown();
+            return 1;
+        }
+    }
+    write_json(out, results, result_count);
+    if (out != stdout) {
+        fclose(out);
+    }
+    perf_counter_close();
+
+    graphics_shutdown();
+    return 0;
+}
\ No newline at end of file
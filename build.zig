@@ -1,69 +1,272 @@
 const std = @import("std");
 
-pub fn build(b: *std.Build) void {
-    const target = b.standardTargetOptions(.{});
-    const optimize = b.standardOptimizeOption(.{});
+const GraphicsBackend = enum { raylib, sdl3, null };
 
-    // Build options for graphics backend selection
-    const graphics_backend = b.option(
-        enum { raylib, sdl3 },
-        "graphics",
-        "Graphics backend to use (raylib or sdl3)",
-    ) orelse .sdl3;
+// Everything the game executable and the wasm build are configured by
+const GameOptions = struct {
+    target: std.Build.ResolvedTarget,
+    optimize: std.builtin.OptimizeMode,
+    graphics_backend: GraphicsBackend,
+    debug_draw: bool,
+    unity: bool,
+    lto: bool,
+    c_flags: []const []const u8,
+    engine_sources: []const []const u8,
+};
 
+fn addGame(b: *std.Build, name: []const u8, options: GameOptions) *std.Build.Step.Compile {
     const exe = b.addExecutable(.{
-        .name = "infinite-runner",
+        .name = name,
         .root_module = b.createModule(.{
-            .target = target,
-            .optimize = optimize,
+            .target = options.target,
+            .optimize = options.optimize,
         }),
     });
 
     // Add C source files
-    exe.addCSourceFiles(.{
-        .files = &.{
-            "src/main.c",
-            "src/engine/graphics.c",
-        },
-        .flags = &.{ "-std=c99", "-Wall", "-Wextra" },
-    });
+    if (options.unity) {
+        exe.addCSourceFiles(.{
+            .files = &.{ "src/main.c", "src/unity.c" },
+            .flags = options.c_flags,
+        });
+    } else {
+        exe.addCSourceFile(.{ .file = b.path("src/main.c"), .flags = options.c_flags });
+        exe.addCSourceFiles(.{
+            .files = options.engine_sources,
+            .flags = options.c_flags,
+        });
+    }
+    if (options.lto) {
+        exe.lto = .full;
+    }
+
+    if (options.debug_draw) {
+        exe.root_module.addCMacro("DEBUG_DRAW_ENABLED", "1");
+    }
 
-    // Add platform-specific backend
-    switch (graphics_backend) {
+    // Add platform-specific backend (already part of src/unity.c in unity builds)
+    switch (options.graphics_backend) {
         .raylib => {
-            exe.addCSourceFile(.{ .file = b.path("src/platform/raylib_impl.c") });
+            if (!options.unity) {
+                exe.addCSourceFile(.{ .file = b.path("src/platform/raylib_impl.c") });
+            }
             exe.root_module.addCMacro("GRAPHICS_BACKEND_RAYLIB", "1");
             exe.linkSystemLibrary("raylib");
         },
         .sdl3 => {
-            exe.addCSourceFile(.{ .file = b.path("src/platform/sdl3_impl.c") });
+            if (!options.unity) {
+                exe.addCSourceFile(.{ .file = b.path("src/platform/sdl3_impl.c") });
+            }
             exe.root_module.addCMacro("GRAPHICS_BACKEND_SDL3", "1");
             exe.linkSystemLibrary("SDL3");
         },
+        // Headless, no window or library: scripted runs on machines without a display
+        .null => {
+            if (!options.unity) {
+                exe.addCSourceFile(.{ .file = b.path("src/platform/null_impl.c") });
+            }
+            exe.root_module.addCMacro("GRAPHICS_BACKEND_NULL", "1");
+        },
     }
     exe.linkLibC();
+    linkThreads(exe);
+    return exe;
+}
 
-    b.installArtifact(exe);
+// Background file reads (src/engine/loader.c) use pthreads where available
+fn linkThreads(exe: *std.Build.Step.Compile) void {
+    if (exe.rootModuleTarget().os.tag != .windows) {
+        exe.linkSystemLibrary("pthread");
+    }
+}
 
-    // SDL3 WebAssembly build using Emscripten
-    const wasm_step = b.step("wasm", "Build SDL3 WebAssembly version using Emscripten");
-    const emcc_cmd = b.addSystemCommand(&.{
-        "emcc",
-        "src/main.c",
-        "src/engine/graphics.c",
-        "src/platform/sdl3_impl.c",
+// SDL3 WebAssembly build through Emscripten, writing `output` (game.js plus
+// game.wasm next to it). Release builds drop the runtime assertions.
+fn addWasmCommand(b: *std.Build, options: GameOptions, output: []const u8) *std.Build.Step.Run {
+    const release = options.optimize != .Debug;
+    const emcc_cmd = b.addSystemCommand(&.{ "emcc", "src/main.c" });
+    if (options.unity) {
+        emcc_cmd.addArg("src/unity.c");
+    } else {
+        emcc_cmd.addArgs(options.engine_sources);
+        emcc_cmd.addArg("src/platform/sdl3_impl.c");
+        emcc_cmd.addArg("src/platform/web_audio.c");
+    }
+    emcc_cmd.addArgs(&.{
         "-DGRAPHICS_BACKEND_SDL3=1",
         "-D__EMSCRIPTEN__=1",
         "-sUSE_SDL=3",
-        "-sASSERTIONS=1",
+        if (release) "-sASSERTIONS=0" else "-sASSERTIONS=1",
         "-sWASM=1",
         "-sASYNCIFY",
-        "-sEXPORTED_FUNCTIONS=[\"_main\"]",
-        "-sEXPORTED_RUNTIME_METHODS=[\"ccall\",\"cwrap\"]",
+        "-sEXPORTED_FUNCTIONS=[\"_main\",\"_web_pointer_event\",\"_web_key_event\",\"_web_audio_start\",\"_web_audio_render\"]",
+        "-sEXPORTED_RUNTIME_METHODS=[\"ccall\",\"cwrap\",\"HEAPF32\",\"specialHTMLTargets\"]",
+        // WebGL on the OffscreenCanvas web/worker.html hands to its worker
+        "-sOFFSCREENCANVAS_SUPPORT=1",
         "-o",
-        "web/game.js",
+        output,
     });
-    wasm_step.dependOn(&emcc_cmd.step);
+    if (release) {
+        emcc_cmd.addArg(if (options.optimize == .ReleaseSmall) "-Oz" else "-O3");
+    }
+    if (options.debug_draw) {
+        emcc_cmd.addArg("-DDEBUG_DRAW_ENABLED=1");
+    }
+    if (options.lto) {
+        emcc_cmd.addArg("-flto");
+    }
+    return emcc_cmd;
+}
+
+pub fn build(b: *std.Build) void {
+    const target = b.standardTargetOptions(.{});
+    const optimize = b.standardOptimizeOption(.{});
+
+    // Build options for graphics backend selection
+    const graphics_backend = b.option(
+        GraphicsBackend,
+        "graphics",
+        "Graphics backend to use (raylib, sdl3 or null for headless)",
+    ) orelse .sdl3;
+
+    // Debug overlay (hitboxes, spawn points), compiled out of ReleaseFast unless asked for
+    const debug_draw_option = b.option(
+        bool,
+        "debug-draw",
+        "Build the debug draw layer (default: on except in ReleaseFast)",
+    );
+    const debug_draw = debug_draw_option orelse (optimize != .ReleaseFast);
+
+    // Whole-engine optimization: one translation unit (see src/unity.c) and/or LTO
+    const unity = b.option(
+        bool,
+        "unity",
+        "Compile the engine and backend as a single translation unit",
+    ) orelse false;
+    const lto = b.option(bool, "lto", "Enable link-time optimization") orelse false;
+
+    // Merged clang profile to optimize with, usually produced by `zig build pgo`
+    const pgo_profile = b.option(
+        []const u8,
+        "pgo-profile",
+        "Apply a profile (.profdata) to the C sources",
+    );
+
+    // Engine sources shared by the game, the wasm build and the bench tool
+    const engine_sources = [_][]const u8{
+        "src/engine/graphics.c",
+        "src/engine/ui.c",
+        "src/engine/animation.c",
+        "src/engine/tilemap.c",
+        "src/engine/debug_draw.c",
+        "src/engine/camera.c",
+        "src/engine/origin.c",
+        "src/engine/arena.c",
+        "src/engine/hashmap.c",
+        "src/engine/intern.c",
+        "src/engine/perf.c",
+        "src/engine/mem.c",
+        "src/engine/simd.c",
+        "src/engine/startup.c",
+        "src/engine/input.c",
+        "src/engine/audio.c",
+        "src/engine/loader.c",
+    };
+    var c_flags: []const []const u8 = &.{ "-std=c99", "-Wall", "-Wextra" };
+    if (pgo_profile) |profile| {
+        c_flags = b.allocator.dupe([]const u8, &.{
+            "-std=c99",
+            "-Wall",
+            "-Wextra",
+            b.fmt("-fprofile-instr-use={s}", .{
+                if (std.fs.path.isAbsolute(profile)) profile else b.pathFromRoot(profile),
+            }),
+            // Backend code the headless profile never runs is expected
+            "-Wno-profile-instr-unprofiled",
+        }) catch @panic("OOM");
+    }
+
+    const game_options = GameOptions{
+        .target = target,
+        .optimize = optimize,
+        .graphics_backend = graphics_backend,
+        .debug_draw = debug_draw,
+        .unity = unity,
+        .lto = lto,
+        .c_flags = c_flags,
+        .engine_sources = &engine_sources,
+    };
+
+    const exe = addGame(b, "infinite-runner", game_options);
+    b.installArtifact(exe);
+
+    // SDL3 WebAssembly build using Emscripten
+    const wasm_step = b.step("wasm", "Build SDL3 WebAssembly version using Emscripten");
+    wasm_step.dependOn(&addWasmCommand(b, game_options, "web/game.js").step);
+
+    // Release matrix: ReleaseFast builds for every shipped target in one run,
+    // installed to zig-out/release/<name>/. x86_64 comes twice, baseline for
+    // any 64-bit CPU and x86-64-v3 (AVX2, FMA, BMI2; Haswell/Zen and newer);
+    // the baseline build still picks AVX2/AVX-512 kernels at runtime (simd.c).
+    // Cross targets link the backend library for that target, so point zig
+    // at it with --sysroot or --search-prefix.
+    const release_step = b.step("release", "Build optimized binaries for all release targets");
+    const release_targets = [_]struct { name: []const u8, query: std.Target.Query }{
+        .{ .name = "x86_64-linux", .query = .{
+            .cpu_arch = .x86_64,
+            .os_tag = .linux,
+            .abi = .gnu,
+            .cpu_model = .baseline,
+        } },
+        .{ .name = "x86_64-linux-v3", .query = .{
+            .cpu_arch = .x86_64,
+            .os_tag = .linux,
+            .abi = .gnu,
+            .cpu_model = .{ .explicit = &std.Target.x86.cpu.x86_64_v3 },
+        } },
+        .{ .name = "aarch64-linux", .query = .{
+            .cpu_arch = .aarch64,
+            .os_tag = .linux,
+            .abi = .gnu,
+            .cpu_model = .baseline,
+        } },
+    };
+    for (release_targets) |release_target| {
+        var release_options = game_options;
+        release_options.target = b.resolveTargetQuery(release_target.query);
+        release_options.optimize = .ReleaseFast;
+        release_options.debug_draw = debug_draw_option orelse false;
+
+        const release_exe = addGame(b, "infinite-runner", release_options);
+        const install = b.addInstallArtifact(release_exe, .{
+            .dest_dir = .{ .override = .{ .custom = b.pathJoin(&.{ "release", release_target.name }) } },
+        });
+        release_step.dependOn(&install.step);
+    }
+
+    // wasm32 goes through emcc like `zig build wasm`, next to a copy of the
+    // web shell. Worker mode (web/worker.html) stays out until it has run
+    // against a real SDL3 build; try it from web/ after `zig build wasm`.
+    var wasm_release_options = game_options;
+    wasm_release_options.optimize = .ReleaseFast;
+    wasm_release_options.debug_draw = debug_draw_option orelse false;
+    const wasm_release_dir = b.getInstallPath(.prefix, "release/wasm32");
+    const wasm_release_mkdir = b.addSystemCommand(&.{ "mkdir", "-p", wasm_release_dir });
+    const wasm_release = addWasmCommand(b, wasm_release_options, b.pathJoin(&.{ wasm_release_dir, "game.js" }));
+    wasm_release.step.dependOn(&wasm_release_mkdir.step);
+    release_step.dependOn(&wasm_release.step);
+    const web_shell_files = [_][]const u8{
+        "index.html",
+        "audio-worklet.js",
+    };
+    for (web_shell_files) |file| {
+        const install = b.addInstallFileWithDir(
+            b.path(b.pathJoin(&.{ "web", file })),
+            .{ .custom = "release/wasm32" },
+            file,
+        );
+        release_step.dependOn(&install.step);
+    }
 
     // Run command
     const run_cmd = b.addRunArtifact(exe);
@@ -74,4 +277,125 @@ pub fn build(b: *std.Build) void {
 
     const run_step = b.step("run", "Run the game");
     run_step.dependOn(&run_cmd.step);
+
+    // Headless benchmarks against the null backend, JSON results on stdout
+    const bench_exe = b.addExecutable(.{
+        .name = "bench",
+        .root_module = b.createModule(.{
+            .target = target,
+            .optimize = optimize,
+        }),
+    });
+    if (unity) {
+        bench_exe.addCSourceFiles(.{
+            .files = &.{ "bench/bench.c", "src/unity.c" },
+            .flags = c_flags,
+        });
+    } else {
+        bench_exe.addCSourceFiles(.{
+            .files = &([_][]const u8{ "bench/bench.c", "src/platform/null_impl.c" } ++ engine_sources),
+            .flags = c_flags,
+        });
+    }
+    if (lto) {
+        bench_exe.lto = .full;
+    }
+    bench_exe.root_module.addCMacro("GRAPHICS_BACKEND_NULL", "1");
+    bench_exe.linkLibC();
+    linkThreads(bench_exe);
+
+    const bench_cmd = b.addRunArtifact(bench_exe);
+    if (b.args) |args| {
+        bench_cmd.addArgs(args);
+    }
+    const bench_step = b.step("bench", "Run the headless benchmarks");
+    bench_step.dependOn(&bench_cmd.step);
+
+    // Profile-guided optimization in one command: build an instrumented bench
+    // and game with the system clang, run the bench scenes and a headless
+    // replay of assets/replays/pgo.txt to collect profiles, merge them into
+    // pgo/default.profdata, then rebuild and install everything with
+    // -Dpgo-profile pointing at it. Needs clang and llvm-profdata no newer
+    // than the LLVM zig bundles (zig cc --version). The instrumented build
+    // uses the same translation unit layout as the final one, since profiles
+    // of static functions are keyed by source file.
+    const pgo_step = b.step("pgo", "Collect bench and replay profiles and rebuild with PGO");
+    const pgo_dir = b.pathFromRoot("pgo");
+    const pgo_data = b.pathJoin(&.{ pgo_dir, "default.profdata" });
+
+    const pgo_clean = b.addSystemCommand(&.{ "rm", "-rf", pgo_dir });
+    const pgo_mkdir = b.addSystemCommand(&.{ "mkdir", "-p", pgo_dir });
+    pgo_mkdir.step.dependOn(&pgo_clean.step);
+
+    const pgo_targets = [_]struct { name: []const u8, main: []const u8, args: []const []const u8 }{
+        // Every bench scene, long enough for the steady state to dominate
+        .{ .name = "bench", .main = "bench/bench.c", .args = &.{ "--min-time", "1", "--json", "/dev/null" } },
+        // A recorded run through the real game loop: input, pause and the
+        // player's jump and crouch paths that no bench scene drives
+        .{ .name = "game", .main = "src/main.c", .args = &.{
+            "--backend",
+            "null",
+            "--headless",
+            "--frames",
+            "1800",
+            "--tick-rate",
+            "60",
+            "--replay",
+            b.pathFromRoot("assets/replays/pgo.txt"),
+        } },
+    };
+
+    const pgo_merge = b.addSystemCommand(&.{
+        "sh",
+        "-c",
+        b.fmt("llvm-profdata merge -o {s} {s}/*.profraw", .{ pgo_data, pgo_dir }),
+    });
+
+    for (pgo_targets) |pgo_target| {
+        const pgo_instrumented = b.pathJoin(&.{ pgo_dir, b.fmt("{s}-instrumented", .{pgo_target.name}) });
+        const pgo_compile = b.addSystemCommand(&.{
+            "clang",
+            "-std=c99",
+            "-O2",
+            "-fprofile-instr-generate",
+            "-pthread",
+            "-DGRAPHICS_BACKEND_NULL=1",
+            "-o",
+            pgo_instrumented,
+            b.pathFromRoot(pgo_target.main),
+        });
+        if (unity) {
+            pgo_compile.addArg(b.pathFromRoot("src/unity.c"));
+        } else {
+            pgo_compile.addArg(b.pathFromRoot("src/platform/null_impl.c"));
+            for (engine_sources) |source| {
+                pgo_compile.addArg(b.pathFromRoot(source));
+            }
+        }
+        pgo_compile.addArg("-lm");
+        pgo_compile.step.dependOn(&pgo_mkdir.step);
+
+        const pgo_collect = b.addSystemCommand(&.{pgo_instrumented});
+        pgo_collect.addArgs(pgo_target.args);
+        pgo_collect.setEnvironmentVariable(
+            "LLVM_PROFILE_FILE",
+            b.pathJoin(&.{ pgo_dir, b.fmt("{s}-%p.profraw", .{pgo_target.name}) }),
+        );
+        pgo_collect.step.dependOn(&pgo_compile.step);
+        pgo_merge.step.dependOn(&pgo_collect.step);
+    }
+
+    const pgo_rebuild = b.addSystemCommand(&.{
+        b.graph.zig_exe,
+        "build",
+        "install",
+        "-Doptimize=ReleaseFast",
+        b.fmt("-Dpgo-profile={s}", .{pgo_data}),
+        b.fmt("-Dgraphics={s}", .{@tagName(graphics_backend)}),
+        if (unity) "-Dunity=true" else "-Dunity=false",
+        if (lto) "-Dlto=true" else "-Dlto=false",
+    });
+    pgo_rebuild.setCwd(b.path("."));
+    pgo_rebuild.step.dependOn(&pgo_merge.step);
+    pgo_step.dependOn(&pgo_rebuild.step);
 }
@@ -0,0 +1,206 @@
+#include "animation.h"
+#include "simd.h"
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+
+#define ANIMATION_QUADS_PER_DRAW 256
+
+// Compiled frame tables, shared by all clips
+static float frame_u0[ANIMATION_MAX_FRAMES];
+static float frame_v0[ANIMATION_MAX_FRAMES];
+static float frame_u1[ANIMATION_MAX_FRAMES];
+static float frame_v1[ANIMATION_MAX_FRAMES];
+static float frame_start[ANIMATION_MAX_FRAMES];  // clip-relative, cumulative
+static float frame_end[ANIMATION_MAX_FRAMES];
+static int frame_count_total = 0;
+
+static int clip_first[ANIMATION_MAX_CLIPS];
+static int clip_count[ANIMATION_MAX_CLIPS];
+static float clip_wrap[ANIMATION_MAX_CLIPS];  // clip length, FLT_MAX if not looping
+static int clip_total = 0;
+
+// Animator state, one entry per animator in parallel arrays. The current
+// frame's time window is cached so the update loop never touches the frame
+// tables unless the frame changes.
+static int anim_clip[ANIMATION_MAX_ANIMATORS];
+static int anim_frame[ANIMATION_MAX_ANIMATORS];
+static float anim_time[ANIMATION_MAX_ANIMATORS];
+static float anim_speed[ANIMATION_MAX_ANIMATORS];
+static float anim_wrap[ANIMATION_MAX_ANIMATORS];
+static float anim_frame_start[ANIMATION_MAX_ANIMATORS];
+static float anim_frame_end[ANIMATION_MAX_ANIMATORS];
+static unsigned char anim_dirty[ANIMATION_MAX_ANIMATORS];
+static bool anim_active[ANIMATION_MAX_ANIMATORS];
+static int anim_high_water = 0;
+
+// Scratch geometry for animation_draw
+static GfxVertex quad_vertices[ANIMATION_QUADS_PER_DRAW * 4];
+static int quad_indices[ANIMATION_QUADS_PER_DRAW * 6];
+static bool quad_indices_ready = false;
+
+int animation_clip_compile(const AnimationFrameDesc* frames, int frame_count, int atlas_width, int atlas_height,
+                           bool loop) {
+    if (frame_count <= 0 || clip_total >= ANIMATION_MAX_CLIPS ||
+        frame_count_total + frame_count > ANIMATION_MAX_FRAMES || atlas_width <= 0 || atlas_height <= 0) {
+        return -1;
+    }
+
+    int clip = clip_total++;
+    int first = frame_count_total;
+    float inv_w = 1.0f / (float)atlas_width;
+    float inv_h = 1.0f / (float)atlas_height;
+    float t = 0.0f;
+
+    for (int i = 0; i < frame_count; i++) {
+        const AnimationFrameDesc* f = &frames[i];
+        int index = first + i;
+        frame_u0[index] = f->source.x * inv_w;
+        frame_v0[index] = f->source.y * inv_h;
+        frame_u1[index] = (f->source.x + f->source.width) * inv_w;
+        frame_v1[index] = (f->source.y + f->source.height) * inv_h;
+        frame_start[index] = t;
+        t += f->duration > 0.0f ? f->duration : 0.0f;
+        frame_end[index] = t;
+    }
+    // A clip that doesn't loop holds its last frame forever
+    if (!loop || t <= 0.0f) {
+        frame_end[first + frame_count - 1] = FLT_MAX;
+    }
+
+    frame_count_total += frame_count;
+    clip_first[clip] = first;
+    clip_count[clip] = frame_count;
+    clip_wrap[clip] = (loop && t > 0.0f) ? t : FLT_MAX;
+    return clip;
+}
+
+static void animator_set_frame(int a, int frame) {
+    anim_frame[a] = frame;
+    anim_frame_start[a] = frame_start[frame];
+    anim_frame_end[a] = frame_end[frame];
+}
+
+int animation_animator_create(int clip) {
+    for (int a = 0; a < ANIMATION_MAX_ANIMATORS; a++) {
+        if (!anim_active[a]) {
+            anim_active[a] = true;
+            anim_speed[a] = 1.0f;
+            if (a >= anim_high_water) {
+                anim_high_water = a + 1;
+            }
+            animation_play(a, clip);
+            return a;
+        }
+    }
+    return -1;
+}
+
+void animation_animator_destroy(int animator) {
+    if (animator < 0 || animator >= anim_high_water) {
+        return;
+    }
+    anim_active[animator] = false;
+    // Parked animators stay in the update loop but never change frame
+    anim_speed[animator] = 0.0f;
+    while (anim_high_water > 0 && !anim_active[anim_high_water - 1]) {
+        anim_high_water--;
+    }
+}
+
+void animation_play(int animator, int clip) {
+    if (animator < 0 || animator >= anim_high_water || clip < 0 || clip >= clip_total) {
+        return;
+    }
+    anim_clip[animator] = clip;
+    anim_time[animator] = 0.0f;
+    anim_wrap[animator] = clip_wrap[clip];
+    anim_dirty[animator] = 0;
+    animator_set_frame(animator, clip_first[clip]);
+}
+
+void animation_set_speed(int animator, float speed) {
+    if (animator >= 0 && animator < anim_high_water && anim_active[animator]) {
+        anim_speed[animator] = speed > 0.0f ? speed : 0.0f;
+    }
+}
+
+int animation_current_frame(int animator) {
+    if (animator < 0 || animator >= anim_high_water) {
+        return 0;
+    }
+    return anim_frame[animator] - clip_first[anim_clip[animator]];
+}
+
+void animation_update(float dt) {
+    int n = anim_high_water;
+
+    // Branch-free pass over contiguous arrays, vectorized for the CPU
+    simd_advance_animators(anim_time, anim_speed, anim_wrap, anim_frame_start, anim_frame_end, anim_dirty, dt, n);
+
+    // Only animators that left their frame's window look at the frame tables
+    for (int i = 0; i < n; i++) {
+        if (!anim_dirty[i]) {
+            continue;
+        }
+        int clip = anim_clip[i];
+        int first = clip_first[clip];
+        int last = first + clip_count[clip] - 1;
+        float t = anim_time[i];
+
+        // Large steps can overshoot by more than one loop
+        if (t >= anim_wrap[i]) {
+            t = fmodf(t, anim_wrap[i]);
+            anim_time[i] = t;
+        }
+        int frame = t < anim_frame_start[i] ? first : anim_frame[i];
+        while (frame < last && t >= frame_end[frame]) {
+            frame++;
+        }
+        animator_set_frame(i, frame);
+        anim_dirty[i] = 0;
+    }
+}
+
+void animation_emit_quad(int animator, GfxRectangle dest, GfxColor tint, GfxVertex* out) {
+    int f = anim_frame[animator];
+    float x1 = dest.x + dest.width;
+    float y1 = dest.y + dest.height;
+
+    out[0] = (GfxVertex){dest.x, dest.y, frame_u0[f], frame_v0[f], tint};
+    out[1] = (GfxVertex){x1, dest.y, frame_u1[f], frame_v0[f], tint};
+    out[2] = (GfxVertex){x1, y1, frame_u1[f], frame_v1[f], tint};
+    out[3] = (GfxVertex){dest.x, y1, frame_u0[f], frame_v1[f], tint};
+}
+
+void animation_draw(int texture_id, const int* animators, const GfxRectangle* dests, int count, GfxColor tint) {
+    if (!quad_indices_ready) {
+        for (int q = 0; q < ANIMATION_QUADS_PER_DRAW; q++) {
+            int* idx = &quad_indices[q * 6];
+            int base = q * 4;
+            idx[0] = base;
+            idx[1] = base + 1;
+            idx[2] = base + 2;
+            idx[3] = base;
+            idx[4] = base + 2;
+            idx[5] = base + 3;
+        }
+        quad_indices_ready = true;
+    }
+
+    int quads = 0;
+    for (int i = 0; i < count; i++) {
+        int a = animators[i];
+        if (a < 0 || a >= anim_high_water || !anim_active[a]) {
+            continue;
+        }
+        animation_emit_quad(a, dests[i], tint, &quad_vertices[quads * 4]);
+        if (++quads == ANIMATION_QUADS_PER_DRAW) {
+            graphics_draw_geometry(texture_id, quad_vertices, quads * 4, quad_indices, quads * 6);
+            quads = 0;
+        }
+    }
+    if (quads > 0) {
+        graphics_draw_geometry(texture_id, quad_vertices, quads * 4, quad_indices, quads * 6);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include "graphics.h"
+#include <stdbool.h>
+
+// Sprite animation. Clips are compiled once into flat tables of atlas UVs
+// and cumulative frame end times; animator state is kept as parallel arrays
+// so animation_update advances every animator in one tight loop and only
+// revisits the few whose frame actually changed.
+
+#define ANIMATION_MAX_FRAMES 1024
+#define ANIMATION_MAX_CLIPS 128
+#define ANIMATION_MAX_ANIMATORS 4096
+
+typedef struct {
+    GfxRectangle source;  // pixels in the atlas
+    float duration;       // seconds
+} AnimationFrameDesc;
+
+// Returns a clip handle, or -1 if the tables are full
+int animation_clip_compile(const AnimationFrameDesc* frames, int frame_count, int atlas_width, int atlas_height,
+                           bool loop);
+
+// Returns an animator handle, or -1 if all animators are in use
+int animation_animator_create(int clip);
+void animation_animator_destroy(int animator);
+void animation_play(int animator, int clip);
+void animation_set_speed(int animator, float speed);
+int animation_current_frame(int animator);
+
+void animation_update(float dt);
+
+// Writes the textured quad for an animator's current frame (4 vertices,
+// top-left, top-right, bottom-right, bottom-left)
+void animation_emit_quad(int animator, GfxRectangle dest, GfxColor tint, GfxVertex* out);
+
+// Draws many animators sharing one atlas with as few geometry calls as possible
+void animation_draw(int texture_id, const int* animators, const GfxRectangle* dests, int count, GfxColor tint);
+
+#endif // ANIMATION_H
\ No newline at end of file
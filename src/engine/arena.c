@@ -0,0 +1,126 @@
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+#define _GNU_SOURCE  // MAP_ANONYMOUS, MAP_HUGETLB and madvise under -std=c99
+#include <sys/mman.h>
+#define ARENA_HUGE_PAGES 1
+#endif
+
+#include "arena.h"
+#include <stdint.h>
+#include <string.h>
+
+#define ARENA_HUGE_PAGE_SIZE ((size_t)2 << 20)
+
+bool arena_init(Arena* arena, size_t capacity, MemTag tag) {
+    arena->base = mem_alloc(tag, capacity);
+    arena->tag = tag;
+    arena->backing = ARENA_BACKING_HEAP;
+    arena->capacity = arena->base ? capacity : 0;
+    arena->used = 0;
+    arena->peak = 0;
+    return arena->base != NULL;
+}
+
+#ifdef ARENA_HUGE_PAGES
+// Maps size bytes starting on a huge page boundary, or returns NULL
+static unsigned char* map_huge(size_t size, ArenaBacking* backing) {
+#ifdef MAP_HUGETLB
+    void* block = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (block != MAP_FAILED) {
+        *backing = ARENA_BACKING_HUGETLB;
+        return block;
+    }
+#endif
+    // No reserved huge pages: over-map, trim to a 2 MB aligned block and ask
+    // for transparent huge pages. If THP is disabled this is still a plain mapping.
+    unsigned char* raw =
+        mmap(NULL, size + ARENA_HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        return NULL;
+    }
+    uintptr_t start = ((uintptr_t)raw + ARENA_HUGE_PAGE_SIZE - 1) & ~(uintptr_t)(ARENA_HUGE_PAGE_SIZE - 1);
+    unsigned char* aligned = (unsigned char*)start;
+    size_t head = (size_t)(aligned - raw);
+    if (head > 0) {
+        munmap(raw, head);
+    }
+    munmap(aligned + size, ARENA_HUGE_PAGE_SIZE - head);
+#ifdef MADV_HUGEPAGE
+    madvise(aligned, size, MADV_HUGEPAGE);
+#endif
+    *backing = ARENA_BACKING_THP;
+    return aligned;
+}
+#endif
+
+bool arena_init_large(Arena* arena, size_t capacity, MemTag tag) {
+#ifdef ARENA_HUGE_PAGES
+    size_t size = (capacity + ARENA_HUGE_PAGE_SIZE - 1) & ~(ARENA_HUGE_PAGE_SIZE - 1);
+    ArenaBacking backing = ARENA_BACKING_HEAP;
+    unsigned char* base = size >= capacity ? map_huge(size, &backing) : NULL;
+    if (base != NULL) {
+        arena->base = base;
+        arena->tag = tag;
+        arena->backing = backing;
+        arena->capacity = size;
+        arena->used = 0;
+        arena->peak = 0;
+        mem_track(tag, size);
+        return true;
+    }
+#endif
+    return arena_init(arena, capacity, tag);
+}
+
+void arena_destroy(Arena* arena) {
+    if (arena->backing == ARENA_BACKING_HEAP) {
+        mem_free(arena->base);
+    }
+#ifdef ARENA_HUGE_PAGES
+    else {
+        munmap(arena->base, arena->capacity);
+        mem_untrack(arena->tag, arena->capacity);
+    }
+#endif
+    arena->base = NULL;
+    arena->backing = ARENA_BACKING_HEAP;
+    arena->capacity = 0;
+    arena->used = 0;
+}
+
+void* arena_alloc(Arena* arena, size_t size, size_t align) {
+    // align must be a power of two
+    uintptr_t current = (uintptr_t)(arena->base + arena->used);
+    size_t padding = (size_t)((align - (current & (align - 1))) & (align - 1));
+    if (arena->base == NULL || padding + size > arena->capacity - arena->used) {
+        return NULL;
+    }
+
+    void* result = arena->base + arena->used + padding;
+    arena->used += padding + size;
+    if (arena->used > arena->peak) {
+        arena->peak = arena->used;
+    }
+    return result;
+}
+
+void* arena_alloc_zero(Arena* arena, size_t size, size_t align) {
+    void* result = arena_alloc(arena, size, align);
+    if (result) {
+        memset(result, 0, size);
+    }
+    return result;
+}
+
+void arena_reset(Arena* arena) {
+    arena->used = 0;
+}
+
+size_t arena_mark(const Arena* arena) {
+    return arena->used;
+}
+
+void arena_release(Arena* arena, size_t mark) {
+    if (mark <= arena->used) {
+        arena->used = mark;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "mem.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Bump allocator over one fixed block. Allocation is a pointer increment,
+// everything is freed at once with arena_reset or arena_destroy, and
+// arena_mark/arena_release give scoped temporary allocations.
+
+typedef enum {
+    ARENA_BACKING_HEAP,
+    ARENA_BACKING_HUGETLB,  // explicit huge pages (reserved via vm.nr_hugepages)
+    ARENA_BACKING_THP       // mmap'd, 2 MB aligned, madvise(MADV_HUGEPAGE)
+} ArenaBacking;
+
+typedef struct {
+    unsigned char* base;
+    MemTag tag;
+    ArenaBacking backing;
+    size_t capacity;
+    size_t used;
+    size_t peak;
+} Arena;
+
+bool arena_init(Arena* arena, size_t capacity, MemTag tag);
+
+// For large, long-lived arenas (entity pools, asset archive, replay
+// buffers): on Linux the block is backed by huge pages so random access
+// over it costs far fewer TLB misses. Capacity is rounded up to 2 MB.
+// Falls back to transparent huge pages, then to arena_init.
+bool arena_init_large(Arena* arena, size_t capacity, MemTag tag);
+void arena_destroy(Arena* arena);
+
+// Returns NULL when the arena is full; memory is not zeroed
+void* arena_alloc(Arena* arena, size_t size, size_t align);
+void* arena_alloc_zero(Arena* arena, size_t size, size_t align);
+
+void arena_reset(Arena* arena);
+size_t arena_mark(const Arena* arena);
+void arena_release(Arena* arena, size_t mark);
+
+// Enough for any scalar or SSE type
+#define ARENA_DEFAULT_ALIGN 16
+
+#define ARENA_NEW_ARRAY(arena, type, count) \
+    ((type*)arena_alloc((arena), sizeof(type) * (size_t)(count), ARENA_DEFAULT_ALIGN))
+
+#endif // ARENA_H
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include "audio.h"
+#include "mem.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    bool used;
+    int channels;  // 1 or 2
+    int sample_rate;
+    int frames;
+    float* samples;  // interleaved
+} AudioSound;
+
+typedef struct {
+    bool active;
+    bool loop;
+    int sound;  // slot
+    float gain;
+    double position;  // in source frames
+    double step;      // source frames per output frame
+} AudioVoice;
+
+static struct {
+    int sample_rate;
+    float master_gain;
+    AudioSound sounds[AUDIO_MAX_SOUNDS];
+    AudioVoice voices[AUDIO_MAX_VOICES];
+} audio = {.master_gain = 1.0f};
+
+static unsigned int wav_read_u16(const unsigned char* bytes) {
+    return (unsigned int)bytes[0] | (unsigned int)bytes[1] << 8;
+}
+
+static unsigned int wav_read_u32(const unsigned char* bytes) {
+    return wav_read_u16(bytes) | (unsigned int)bytes[2] << 16 | (unsigned int)bytes[3] << 24;
+}
+
+void audio_init(int sample_rate) {
+    audio.sample_rate = sample_rate;
+}
+
+void audio_shutdown(void) {
+    for (int i = 0; i < AUDIO_MAX_SOUNDS; i++) {
+        if (audio.sounds[i].used) {
+            audio_unload(i + 1);
+        }
+    }
+    audio.sample_rate = 0;
+}
+
+int audio_sample_rate(void) {
+    return audio.sample_rate;
+}
+
+// Decodes the fmt and data chunks of a RIFF/WAVE file in memory
+static bool decode_wav(const unsigned char* bytes, size_t size, AudioSound* sound) {
+    if (size < 12 || memcmp(bytes, "RIFF", 4) != 0 || memcmp(bytes + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    unsigned int format = 0, channels = 0, rate = 0, bits = 0;
+    const unsigned char* data = NULL;
+    size_t data_size = 0;
+    size_t offset = 12;
+    while (offset + 8 <= size) {
+        const unsigned char* chunk = bytes + offset;
+        size_t chunk_size = wav_read_u32(chunk + 4);
+        if (chunk_size > size - offset - 8) {
+            chunk_size = size - offset - 8;  // truncated file, use what's there
+        }
+        if (memcmp(chunk, "fmt ", 4) == 0 && chunk_size >= 16) {
+            format = wav_read_u16(chunk + 8);
+            channels = wav_read_u16(chunk + 10);
+            rate = wav_read_u32(chunk + 12);
+            bits = wav_read_u16(chunk + 22);
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            data = chunk + 8;
+            data_size = chunk_size;
+        }
+        offset += 8 + chunk_size + (chunk_size & 1);  // chunks are word aligned
+    }
+
+    bool pcm16 = format == 1 && bits == 16;
+    bool float32 = format == 3 && bits == 32;
+    if (data == NULL || (!pcm16 && !float32) || channels < 1 || channels > 2 || rate == 0) {
+        return false;
+    }
+
+    size_t frame_bytes = channels * (bits / 8);
+    int frames = (int)(data_size / frame_bytes);
+    float* samples = mem_alloc(MEM_TAG_AUDIO, (size_t)frames * channels * sizeof(float));
+    if (samples == NULL) {
+        return false;
+    }
+    for (size_t i = 0; i < (size_t)frames * channels; i++) {
+        if (pcm16) {
+            samples[i] = (float)(short)wav_read_u16(data + i * 2) / 32768.0f;
+        } else {
+            unsigned int word = wav_read_u32(data + i * 4);
+            memcpy(&samples[i], &word, sizeof(float));
+        }
+    }
+
+    sound->channels = (int)channels;
+    sound->sample_rate = (int)rate;
+    sound->frames = frames;
+    sound->samples = samples;
+    return true;
+}
+
+int audio_load_wav(const char* path) {
+    int slot = 0;
+    while (slot < AUDIO_MAX_SOUNDS && audio.sounds[slot].used) {
+        slot++;
+    }
+    if (slot == AUDIO_MAX_SOUNDS) {
+        fprintf(stderr, "Sound table full, cannot load %s\n", path);
+        return 0;
+    }
+
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "Sound %s could not be loaded!\n", path);
+        return 0;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char* bytes = size > 0 ? mem_alloc(MEM_TAG_AUDIO, (size_t)size) : NULL;
+    bool ok = bytes != NULL && fread(bytes, 1, (size_t)size, file) == (size_t)size;
+    fclose(file);
+
+    AudioSound sound = {0};
+    ok = ok && decode_wav(bytes, (size_t)size, &sound);
+    mem_free(bytes);
+    if (!ok) {
+        fprintf(stderr, "Sound %s could not be loaded!\n", path);
+        return 0;
+    }
+
+    sound.used = true;
+    audio.sounds[slot] = sound;
+    return slot + 1;
+}
+
+void audio_unload(int sound) {
+    if (sound <= 0 || sound > AUDIO_MAX_SOUNDS || !audio.sounds[sound - 1].used) {
+        return;
+    }
+    for (int i = 0; i < AUDIO_MAX_VOICES; i++) {
+        if (audio.voices[i].active && audio.voices[i].sound == sound - 1) {
+            audio.voices[i].active = false;
+        }
+    }
+    mem_free(audio.sounds[sound - 1].samples);
+    audio.sounds[sound - 1] = (AudioSound){0};
+}
+
+int audio_play(int sound, float gain, bool loop) {
+    if (audio.sample_rate == 0 || sound <= 0 || sound > AUDIO_MAX_SOUNDS || !audio.sounds[sound - 1].used) {
+        return -1;
+    }
+    for (int i = 0; i < AUDIO_MAX_VOICES; i++) {
+        if (!audio.voices[i].active) {
+            audio.voices[i] = (AudioVoice){
+                .active = true,
+                .loop = loop,
+                .sound = sound - 1,
+                .gain = gain,
+                .position = 0.0,
+                .step = (double)audio.sounds[sound - 1].sample_rate / audio.sample_rate,
+            };
+            return i;
+        }
+    }
+    return -1;
+}
+
+void audio_stop(int voice) {
+    if (voice >= 0 && voice < AUDIO_MAX_VOICES) {
+        audio.voices[voice].active = false;
+    }
+}
+
+void audio_set_master_gain(float gain) {
+    audio.master_gain = gain;
+}
+
+static void mix_voice(AudioVoice* voice, float* out, int frames) {
+    const AudioSound* sound = &audio.sounds[voice->sound];
+    const float* samples = sound->samples;
+    int channels = sound->channels;
+    float gain = voice->gain * audio.master_gain;
+
+    for (int i = 0; i < frames; i++) {
+        if (voice->position >= sound->frames) {
+            if (!voice->loop || sound->frames == 0) {
+                voice->active = false;
+                return;
+            }
+            // fmod, not one subtraction: a step of a whole loop or more
+            // (a tiny loop at a higher rate than the output) would stay past the end
+            voice->position = fmod(voice->position, (double)sound->frames);
+        }
+
+        int index = (int)voice->position;
+        int next = index + 1 < sound->frames ? index + 1 : (voice->loop ? 0 : index);
+        float t = (float)(voice->position - index);
+        for (int c = 0; c < AUDIO_CHANNELS; c++) {
+            int source = channels == 1 ? 0 : c;
+            float a = samples[index * channels + source];
+            float b = samples[next * channels + source];
+            out[i * AUDIO_CHANNELS + c] += (a + (b - a) * t) * gain;
+        }
+        voice->position += voice->step;
+    }
+}
+
+void audio_mix(float* out, int frames) {
+    memset(out, 0, (size_t)frames * AUDIO_CHANNELS * sizeof(float));
+    for (int i = 0; i < AUDIO_MAX_VOICES; i++) {
+        if (audio.voices[i].active) {
+            mix_voice(&audio.voices[i], out, frames);
+        }
+    }
+    for (int i = 0; i < frames * AUDIO_CHANNELS; i++) {
+        out[i] = out[i] > 1.0f ? 1.0f : (out[i] < -1.0f ? -1.0f : out[i]);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <stdbool.h>
+
+// Software mixer. Sounds are decoded to float samples on load; playing
+// voices are mixed (resampled to the output rate, linear interpolation)
+// into interleaved stereo by audio_mix, which the platform's audio output
+// calls to fill its buffer. On the web that is a ring buffer drained by an
+// AudioWorklet (src/platform/web_audio.c, web/audio-worklet.js).
+//
+// Not thread-safe: play, stop and mix from the same thread.
+
+#define AUDIO_CHANNELS 2
+#define AUDIO_MAX_SOUNDS 64
+#define AUDIO_MAX_VOICES 32
+
+void audio_init(int sample_rate);
+void audio_shutdown(void);
+int audio_sample_rate(void);  // 0 before audio_init
+
+// WAV files, 16-bit PCM or 32-bit float, mono or stereo. Returns a sound
+// handle, or 0 on failure.
+int audio_load_wav(const char* path);
+void audio_unload(int sound);
+
+// Returns a voice handle, or -1 if all voices are busy
+int audio_play(int sound, float gain, bool loop);
+void audio_stop(int voice);
+void audio_set_master_gain(float gain);
+
+// Writes frames * AUDIO_CHANNELS samples, silence where nothing plays
+void audio_mix(float* out, int frames);
+
+#endif // AUDIO_H
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "camera.h"
+#include <math.h>
+
+#define CAMERA_NOISE_SIZE 256
+#define CAMERA_SHAKE_MAX_OFFSET 12.0f
+#define CAMERA_SHAKE_FREQUENCY 30.0f  // noise samples per second
+#define CAMERA_TRAUMA_DECAY 1.5f      // per second
+
+typedef struct {
+    float view_width, view_height;
+    float anchor_x, anchor_y;
+    float target_x, target_y;
+    float x, y;  // world point shown at the anchor
+    float smoothing;
+    float zoom;
+
+    float trauma;
+    float shake_time;
+    float shake_x, shake_y;
+    float noise[CAMERA_NOISE_SIZE];
+} Camera;
+
+static Camera camera;
+
+static void camera_build_noise(unsigned int seed) {
+    // xorshift values in [-1, 1]; sampled with linear interpolation for
+    // smooth value noise
+    unsigned int state = seed ? seed : 0x9E3779B9u;
+    for (int i = 0; i < CAMERA_NOISE_SIZE; i++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        camera.noise[i] = (float)(state & 0xFFFF) / 32767.5f - 1.0f;
+    }
+}
+
+static float camera_noise(float t) {
+    float base = floorf(t);
+    float frac = t - base;
+    int i = (int)base & (CAMERA_NOISE_SIZE - 1);
+    int j = (i + 1) & (CAMERA_NOISE_SIZE - 1);
+    return camera.noise[i] + (camera.noise[j] - camera.noise[i]) * frac;
+}
+
+void camera_init(float view_width, float view_height) {
+    camera = (Camera){0};
+    camera.view_width = view_width;
+    camera.view_height = view_height;
+    camera.anchor_x = view_width * 0.5f;
+    camera.anchor_y = view_height * 0.5f;
+    camera.smoothing = 8.0f;
+    camera.zoom = 1.0f;
+    camera_build_noise(0);
+}
+
+void camera_set_anchor(float screen_x, float screen_y) {
+    camera.anchor_x = screen_x;
+    camera.anchor_y = screen_y;
+}
+
+void camera_set_target(float x, float y) {
+    camera.target_x = x;
+    camera.target_y = y;
+}
+
+void camera_set_smoothing(float rate) {
+    camera.smoothing = rate > 0.0f ? rate : 0.0f;
+}
+
+void camera_set_zoom(float zoom) {
+    camera.zoom = zoom > 0.0f ? zoom : 1.0f;
+}
+
+void camera_snap(void) {
+    camera.x = camera.target_x;
+    camera.y = camera.target_y;
+}
+
+void camera_shake(float trauma) {
+    camera.trauma += trauma;
+    if (camera.trauma > 1.0f) {
+        camera.trauma = 1.0f;
+    }
+}
+
+void camera_set_shake_seed(unsigned int seed) {
+    camera_build_noise(seed);
+}
+
+void camera_update(float dt) {
+    if (camera.smoothing > 0.0f) {
+        // Frame-rate independent exponential approach
+        float k = 1.0f - expf(-camera.smoothing * dt);
+        camera.x += (camera.target_x - camera.x) * k;
+        camera.y += (camera.target_y - camera.y) * k;
+    } else {
+        camera_snap();
+    }
+
+    camera.shake_x = 0.0f;
+    camera.shake_y = 0.0f;
+    if (camera.trauma > 0.0f) {
+        float strength = camera.trauma * camera.trauma * CAMERA_SHAKE_MAX_OFFSET;
+        camera.shake_time += dt * CAMERA_SHAKE_FREQUENCY;
+        // Half a table apart so the axes are uncorrelated
+        camera.shake_x = camera_noise(camera.shake_time) * strength;
+        camera.shake_y = camera_noise(camera.shake_time + CAMERA_NOISE_SIZE / 2) * strength;
+
+        camera.trauma -= CAMERA_TRAUMA_DECAY * dt;
+        if (camera.trauma < 0.0f) {
+            camera.trauma = 0.0f;
+        }
+    }
+    camera.shake_time = fmodf(camera.shake_time, (float)CAMERA_NOISE_SIZE);
+}
+
+// World position of the screen's top-left corner
+static void camera_view_origin(float* x, float* y) {
+    *x = camera.x + camera.shake_x - camera.anchor_x / camera.zoom;
+    *y = camera.y + camera.shake_y - camera.anchor_y / camera.zoom;
+}
+
+void camera_begin(void) {
+    float x, y;
+    camera_view_origin(&x, &y);
+    graphics_set_view(x, y, camera.zoom);
+}
+
+void camera_end(void) {
+    graphics_reset_view();
+}
+
+GfxVector2 camera_world_to_screen(GfxVector2 point) {
+    float x, y;
+    camera_view_origin(&x, &y);
+    return (GfxVector2){(point.x - x) * camera.zoom, (point.y - y) * camera.zoom};
+}
+
+GfxVector2 camera_screen_to_world(GfxVector2 point) {
+    float x, y;
+    camera_view_origin(&x, &y);
+    return (GfxVector2){point.x / camera.zoom + x, point.y / camera.zoom + y};
+}
+
+GfxRectangle camera_visible_rect(void) {
+    float x, y;
+    camera_view_origin(&x, &y);
+    return (GfxRectangle){x, y, camera.view_width / camera.zoom, camera.view_height / camera.zoom};
+}
+
+void camera_rebase(float dx, float dy) {
+    camera.x -= dx;
+    camera.y -= dy;
+    camera.target_x -= dx;
+    camera.target_y -= dy;
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#include "graphics.h"
+
+// 2D camera that follows a target with exponential smoothing and adds screen
+// shake. Draws between camera_begin and camera_end are given in world space;
+// the graphics layer converts them to screen space as the batch is recorded
+// and culls against clip rects after the transform.
+//
+// Shake samples precomputed noise tables, so it costs two table lookups per
+// frame and is reproducible for a given seed.
+
+void camera_init(float view_width, float view_height);
+
+// Where the target should sit on screen, e.g. the left third for a runner
+void camera_set_anchor(float screen_x, float screen_y);
+void camera_set_target(float x, float y);
+void camera_set_smoothing(float rate);  // per second, 0 = locked to target
+void camera_set_zoom(float zoom);
+void camera_snap(void);                 // jump to the target, no smoothing
+
+// Adds trauma in [0, 1]; shake strength is trauma squared and decays over time
+void camera_shake(float trauma);
+void camera_set_shake_seed(unsigned int seed);
+
+void camera_update(float dt);
+
+void camera_begin(void);
+void camera_end(void);
+
+GfxVector2 camera_world_to_screen(GfxVector2 point);
+GfxVector2 camera_screen_to_world(GfxVector2 point);
+
+// World-space rectangle currently on screen, shake included
+GfxRectangle camera_visible_rect(void);
+
+// Call after dx, dy has been subtracted from every world coordinate (origin
+// rebasing); keeps the camera on the same view with no visible jump
+void camera_rebase(float dx, float dy);
+
+#endif // CAMERA_H
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "debug_draw.h"
+
+#ifdef DEBUG_DRAW_ENABLED
+
+#include <math.h>
+#include <string.h>
+
+#define DEBUG_DRAW_MAX_LINES 2048
+#define DEBUG_DRAW_MAX_TEXTS 128
+#define DEBUG_DRAW_TEXT_POOL 4096
+#define DEBUG_DRAW_TEXT_SIZE 10
+
+typedef struct {
+    int offset, length;
+    int x, y;
+    GfxColor color;
+} DebugText;
+
+typedef struct {
+    bool enabled;
+
+    // Lines are expanded to 1px quads as they are recorded
+    GfxVertex vertices[DEBUG_DRAW_MAX_LINES * 4];
+    int indices[DEBUG_DRAW_MAX_LINES * 6];
+    int line_count;
+    bool indices_ready;
+
+    // Text is copied so callers can format into stack buffers
+    DebugText texts[DEBUG_DRAW_MAX_TEXTS];
+    int text_count;
+    char text_pool[DEBUG_DRAW_TEXT_POOL];
+    int text_pool_used;
+} DebugDrawLayer;
+
+static DebugDrawLayer layer = {.enabled = true};
+
+void debug_draw_set_enabled(bool enabled) {
+    layer.enabled = enabled;
+    if (!enabled) {
+        layer.line_count = 0;
+        layer.text_count = 0;
+        layer.text_pool_used = 0;
+    }
+}
+
+bool debug_draw_is_enabled(void) {
+    return layer.enabled;
+}
+
+void debug_draw_toggle(void) {
+    debug_draw_set_enabled(!layer.enabled);
+}
+
+void debug_draw_line(float x0, float y0, float x1, float y1, GfxColor color) {
+    if (!layer.enabled || layer.line_count >= DEBUG_DRAW_MAX_LINES) {
+        return;
+    }
+
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    float len = sqrtf(dx * dx + dy * dy);
+    if (len <= 0.0f) {
+        return;
+    }
+    // Half-pixel offset along the normal
+    float nx = -dy / len * 0.5f;
+    float ny = dx / len * 0.5f;
+
+    GfxVertex* v = &layer.vertices[layer.line_count * 4];
+    v[0] = (GfxVertex){x0 + nx, y0 + ny, 0.0f, 0.0f, color};
+    v[1] = (GfxVertex){x1 + nx, y1 + ny, 0.0f, 0.0f, color};
+    v[2] = (GfxVertex){x1 - nx, y1 - ny, 0.0f, 0.0f, color};
+    v[3] = (GfxVertex){x0 - nx, y0 - ny, 0.0f, 0.0f, color};
+    layer.line_count++;
+}
+
+void debug_draw_box(GfxRectangle rect, GfxColor color) {
+    float x1 = rect.x + rect.width;
+    float y1 = rect.y + rect.height;
+    debug_draw_line(rect.x, rect.y, x1, rect.y, color);
+    debug_draw_line(x1, rect.y, x1, y1, color);
+    debug_draw_line(x1, y1, rect.x, y1, color);
+    debug_draw_line(rect.x, y1, rect.x, rect.y, color);
+}
+
+void debug_draw_text(GfxStringView text, int x, int y, GfxColor color) {
+    if (!layer.enabled || layer.text_count >= DEBUG_DRAW_MAX_TEXTS ||
+        layer.text_pool_used + text.length > DEBUG_DRAW_TEXT_POOL || text.length <= 0) {
+        return;
+    }
+    memcpy(&layer.text_pool[layer.text_pool_used], text.data, (size_t)text.length);
+    layer.texts[layer.text_count++] = (DebugText){layer.text_pool_used, text.length, x, y, color};
+    layer.text_pool_used += text.length;
+}
+
+void debug_draw_flush(void) {
+    if (!layer.indices_ready) {
+        for (int q = 0; q < DEBUG_DRAW_MAX_LINES; q++) {
+            int* idx = &layer.indices[q * 6];
+            int base = q * 4;
+            idx[0] = base;
+            idx[1] = base + 1;
+            idx[2] = base + 2;
+            idx[3] = base;
+            idx[4] = base + 2;
+            idx[5] = base + 3;
+        }
+        layer.indices_ready = true;
+    }
+
+    if (layer.line_count > 0) {
+        graphics_draw_geometry(0, layer.vertices, layer.line_count * 4, layer.indices, layer.line_count * 6);
+    }
+    for (int i = 0; i < layer.text_count; i++) {
+        DebugText* t = &layer.texts[i];
+        graphics_draw_text_view(graphics_string_view_n(&layer.text_pool[t->offset], t->length), t->x, t->y,
+                                DEBUG_DRAW_TEXT_SIZE, t->color);
+    }
+
+    layer.line_count = 0;
+    layer.text_count = 0;
+    layer.text_pool_used = 0;
+}
+
+#endif // DEBUG_DRAW_ENABLED
\ No newline at end of file
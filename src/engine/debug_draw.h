@@ -0,0 +1,41 @@
+#ifndef DEBUG_DRAW_H
+#define DEBUG_DRAW_H
+
+#include "graphics.h"
+#include <stdbool.h>
+
+// Debug overlay for hitboxes, spawn points and broadphase cells. Calls are
+// accumulated into their own layer and drawn by debug_draw_flush in one
+// geometry call plus the text, so they don't interleave with (and distort
+// the profile of) the game's own draws.
+//
+// Built only when DEBUG_DRAW_ENABLED is defined (zig build -Ddebug-draw,
+// on by default except in ReleaseFast). Otherwise every call compiles to
+// nothing and its arguments are not evaluated.
+
+#ifdef DEBUG_DRAW_ENABLED
+
+void debug_draw_set_enabled(bool enabled);
+bool debug_draw_is_enabled(void);
+void debug_draw_toggle(void);
+
+void debug_draw_line(float x0, float y0, float x1, float y1, GfxColor color);
+void debug_draw_box(GfxRectangle rect, GfxColor color);
+void debug_draw_text(GfxStringView text, int x, int y, GfxColor color);
+
+// Draws everything recorded since the last flush, then clears the layer
+void debug_draw_flush(void);
+
+#else
+
+#define debug_draw_set_enabled(enabled) ((void)0)
+#define debug_draw_is_enabled() false
+#define debug_draw_toggle() ((void)0)
+#define debug_draw_line(x0, y0, x1, y1, color) ((void)0)
+#define debug_draw_box(rect, color) ((void)0)
+#define debug_draw_text(text, x, y, color) ((void)0)
+#define debug_draw_flush() ((void)0)
+
+#endif // DEBUG_DRAW_ENABLED
+
+#endif // DEBUG_DRAW_H
\ No newline at end of file
@@ -1,26 +1,435 @@
 #include "graphics.h"
+#include "loader.h"
+#include "mem.h"
+#include "simd.h"
+#include <math.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 // Forward declarations for platform-specific implementations
-extern void platform_graphics_init(int width, int height, const char* title);
+extern void platform_graphics_init(int width, int height, const char* title, unsigned int flags);
 extern void platform_graphics_shutdown(void);
 extern bool platform_graphics_should_close(void);
 extern void platform_graphics_begin_frame(void);
 extern void platform_graphics_end_frame(void);
 extern void platform_graphics_clear(GfxColor color);
-extern void platform_graphics_draw_rectangle(GfxRectangle rect, GfxColor color);
 extern void platform_graphics_draw_texture(int texture_id, GfxRectangle dest, GfxColor tint);
 extern void platform_graphics_draw_text(const char* text, int x, int y, int size, GfxColor color);
-extern int platform_graphics_load_texture(const char* filename);
+extern int platform_graphics_load_texture(const char* filename, bool premultiply);
+extern int platform_graphics_load_texture_memory(const char* name, const unsigned char* data, size_t size,
+                                                 bool premultiply);
+extern void platform_graphics_set_blend_mode(GfxBlendMode mode);
+extern void platform_graphics_set_clip(const GfxRectangle* rect);
+extern bool platform_graphics_get_texture_size(int texture_id, int* width, int* height);
 extern void platform_graphics_unload_texture(int texture_id);
+extern void platform_graphics_draw_geometry(int texture_id, const GfxVertex* vertices, int vertex_count,
+                                           const int* indices, int index_count);
+extern void platform_graphics_draw_text_view(const char* text, int length, int x, int y, int size, GfxColor color);
+extern int platform_graphics_measure_text_view(const char* text, int length, int size);
+extern double platform_graphics_get_time(void);
 
 static GraphicsBackend current_backend = GRAPHICS_RAYLIB;
+static unsigned int window_flags = 0;
+
+// Direct-mapped cache of measured text widths, keyed by hash, length and size
+#define TEXT_MEASURE_CACHE_SIZE 256
+
+typedef struct {
+    unsigned int hash;
+    int length;
+    int size;
+    int width;
+} TextMeasureEntry;
+
+static TextMeasureEntry text_measure_cache[TEXT_MEASURE_CACHE_SIZE];
+
+// Shared vertex batch. Rectangles, primitives and small geometry are
+// appended here and submitted in one platform call whenever the texture
+// changes, the batch fills up, or an unbatched draw needs to go out in order.
+#define GFX_BATCH_MAX_VERTICES 4096
+#define GFX_BATCH_MAX_INDICES (GFX_BATCH_MAX_VERTICES * 3 / 2)
+
+typedef struct {
+    GfxVertex vertices[GFX_BATCH_MAX_VERTICES];
+    int indices[GFX_BATCH_MAX_INDICES];
+    int vertex_count;
+    int index_count;
+    int texture_id;
+    GfxBlendMode blend_mode;
+    int view_start;  // first vertex not yet moved from world to screen space
+} GfxBatch;
+
+static GfxBatch batch;
+
+// World-to-screen view: screen = (world - offset) * zoom. Batched vertices
+// are recorded in world space and converted in one pass over the pending
+// range when the view changes or the batch is flushed.
+typedef struct {
+    bool active;
+    float x, y;
+    float zoom;
+} GfxView;
+
+static GfxView view = {false, 0.0f, 0.0f, 1.0f};
+static GfxVertex* view_scratch = NULL;
+static int view_scratch_capacity = 0;
+
+// Blend mode for new draws, and the one the backend currently has set
+static GfxBlendMode current_blend_mode = GFX_BLEND_ALPHA;
+static GfxBlendMode backend_blend_mode = GFX_BLEND_ALPHA;
+
+// Unit circle tables for each segment count (multiples of 4 so rounded
+// rectangle corners can use a quarter of one), built on first use
+#define GFX_CIRCLE_MAX_SEGMENTS 64
+#define GFX_CIRCLE_TABLES (GFX_CIRCLE_MAX_SEGMENTS / 4)
+
+typedef struct {
+    bool ready;
+    float cos_table[GFX_CIRCLE_MAX_SEGMENTS + 1];
+    float sin_table[GFX_CIRCLE_MAX_SEGMENTS + 1];
+} GfxCircleTable;
+
+static GfxCircleTable circle_tables[GFX_CIRCLE_TABLES];
+
+// Clip rectangle stack. Each entry is already intersected with the one below
+// it, and draws entirely outside the top entry are dropped before they reach
+// the batch.
+#define GFX_CLIP_STACK_MAX 16
+
+static GfxRectangle clip_stack[GFX_CLIP_STACK_MAX];
+static int clip_depth = 0;
+// Pushes past the limit, so their pops leave the real stack alone; until
+// then draws keep the deepest rect that fit, which is never tighter
+static int clip_overflow = 0;
+
+// Texture residency. Callers hold handles into this table, which stay valid
+// while the backend texture behind them is evicted and reloaded, so memory
+// can be capped without anyone holding a dangling ID. Drawing an evicted
+// texture skips the draw and queues a reload: the file is read on the
+// loader thread, and decoded and uploaded at the start of a later frame.
+#define GFX_MAX_TEXTURES 64
+#define GFX_TEXTURE_PATH_MAX 256
+#define GFX_TEXTURE_RELOADS_PER_FRAME 2
+
+typedef struct {
+    bool used;
+    bool premultiplied;
+    bool reload_requested;
+    bool reading;      // read_request is in flight on the loader
+    int read_request;
+    int backend_id;  // 0 while evicted
+    int width, height;
+    size_t bytes;
+    unsigned int last_used_frame;
+    char path[GFX_TEXTURE_PATH_MAX];  // empty when the texture can't be reloaded
+} GfxTextureRecord;
+
+static GfxTextureRecord texture_records[GFX_MAX_TEXTURES];
+static size_t texture_budget = 0;  // bytes, 0 = unlimited
+static unsigned int frame_index = 0;
+static GfxTextureStats texture_stats;
+
+static GfxFrameStats frame_stats;
+static GfxFrameStats last_frame_stats;
+
+static void view_to_screen(float* x, float* y) {
+    if (view.active) {
+        *x = (*x - view.x) * view.zoom;
+        *y = (*y - view.y) * view.zoom;
+    }
+}
+
+static void view_apply(GfxVertex* vertices, int count) {
+    simd_transform_vertices(vertices, count, view.zoom, -view.x * view.zoom, -view.y * view.zoom);
+}
+
+static void batch_apply_view(void) {
+    if (view.active && batch.vertex_count > batch.view_start) {
+        view_apply(&batch.vertices[batch.view_start], batch.vertex_count - batch.view_start);
+    }
+    batch.view_start = batch.vertex_count;
+}
+
+// Bounds are given in world space when a view is set; clip rects are always
+// in screen space
+static bool clip_rejects(float x0, float y0, float x1, float y1) {
+    if (clip_depth == 0) {
+        return false;
+    }
+    view_to_screen(&x0, &y0);
+    view_to_screen(&x1, &y1);
+    const GfxRectangle* clip = &clip_stack[clip_depth - 1];
+    if (x1 <= clip->x || y1 <= clip->y || x0 >= clip->x + clip->width || y0 >= clip->y + clip->height) {
+        frame_stats.culled++;
+        return true;
+    }
+    return false;
+}
+
+static bool clip_rejects_rect(GfxRectangle rect) {
+    return clip_rejects(rect.x, rect.y, rect.x + rect.width, rect.y + rect.height);
+}
+
+static bool clip_rejects_vertices(const GfxVertex* vertices, int count) {
+    if (clip_depth == 0) {
+        return false;
+    }
+    float min_x = vertices[0].x, max_x = vertices[0].x;
+    float min_y = vertices[0].y, max_y = vertices[0].y;
+    for (int i = 1; i < count; i++) {
+        min_x = vertices[i].x < min_x ? vertices[i].x : min_x;
+        max_x = vertices[i].x > max_x ? vertices[i].x : max_x;
+        min_y = vertices[i].y < min_y ? vertices[i].y : min_y;
+        max_y = vertices[i].y > max_y ? vertices[i].y : max_y;
+    }
+    return clip_rejects(min_x, min_y, max_x, max_y);
+}
+
+static void apply_blend_mode(GfxBlendMode mode) {
+    if (mode != backend_blend_mode) {
+        platform_graphics_set_blend_mode(mode);
+        backend_blend_mode = mode;
+    }
+}
+
+void graphics_flush(void) {
+    batch_apply_view();
+    if (batch.index_count > 0) {
+        apply_blend_mode(batch.blend_mode);
+        platform_graphics_draw_geometry(batch.texture_id, batch.vertices, batch.vertex_count, batch.indices,
+                                        batch.index_count);
+        frame_stats.draw_calls++;
+        frame_stats.vertices += batch.vertex_count;
+    }
+    batch.vertex_count = 0;
+    batch.index_count = 0;
+    batch.view_start = 0;
+}
+
+// Makes room for a shape and returns the index of its first vertex. Callers
+// must not ask for more than the batch capacity.
+static int batch_reserve(int texture_id, int vertex_count, int index_count) {
+    if (batch.texture_id != texture_id || batch.blend_mode != current_blend_mode ||
+        batch.vertex_count + vertex_count > GFX_BATCH_MAX_VERTICES ||
+        batch.index_count + index_count > GFX_BATCH_MAX_INDICES) {
+        graphics_flush();
+        batch.texture_id = texture_id;
+        batch.blend_mode = current_blend_mode;
+    }
+    return batch.vertex_count;
+}
+
+static void batch_quad(int texture_id, const GfxVertex quad[4]) {
+    int base = batch_reserve(texture_id, 4, 6);
+    int* idx = &batch.indices[batch.index_count];
+
+    memcpy(&batch.vertices[base], quad, 4 * sizeof(GfxVertex));
+    idx[0] = base;
+    idx[1] = base + 1;
+    idx[2] = base + 2;
+    idx[3] = base;
+    idx[4] = base + 2;
+    idx[5] = base + 3;
+    batch.vertex_count += 4;
+    batch.index_count += 6;
+}
+
+// Triangle fan over vertices already written at [base, base + count)
+static void batch_fan(int base, int count) {
+    int* idx = &batch.indices[batch.index_count];
+    for (int i = 1; i + 1 < count; i++) {
+        *idx++ = base;
+        *idx++ = base + i;
+        *idx++ = base + i + 1;
+    }
+    batch.vertex_count += count;
+    batch.index_count += (count - 2) * 3;
+}
+
+static int circle_segments(float radius) {
+    int segments = ((int)(radius * 0.5f) + 3) & ~3;
+    if (segments < 8) {
+        segments = 8;
+    }
+    return segments > GFX_CIRCLE_MAX_SEGMENTS ? GFX_CIRCLE_MAX_SEGMENTS : segments;
+}
+
+static const GfxCircleTable* circle_table(int segments) {
+    GfxCircleTable* table = &circle_tables[segments / 4 - 1];
+    if (!table->ready) {
+        for (int i = 0; i <= segments; i++) {
+            float angle = (float)i * 6.28318530718f / (float)segments;
+            table->cos_table[i] = cosf(angle);
+            table->sin_table[i] = sinf(angle);
+        }
+        table->ready = true;
+    }
+    return table;
+}
+
+static GfxTextureRecord* texture_record(int texture_id) {
+    if (texture_id <= 0 || texture_id > GFX_MAX_TEXTURES || !texture_records[texture_id - 1].used) {
+        return NULL;
+    }
+    return &texture_records[texture_id - 1];
+}
+
+static void texture_evict(GfxTextureRecord* record) {
+    platform_graphics_unload_texture(record->backend_id);
+    record->backend_id = 0;
+    texture_stats.resident_bytes -= record->bytes;
+    texture_stats.resident_count--;
+    texture_stats.evictions++;
+}
+
+// Evicts least recently drawn textures until incoming bytes fit the budget.
+// Textures drawn this frame may still be referenced by the batch and are kept,
+// so the budget can be exceeded while one frame needs more than it allows.
+static void texture_enforce_budget(size_t incoming) {
+    while (texture_budget > 0 && texture_stats.resident_bytes + incoming > texture_budget) {
+        GfxTextureRecord* oldest = NULL;
+        for (int i = 0; i < GFX_MAX_TEXTURES; i++) {
+            GfxTextureRecord* record = &texture_records[i];
+            if (record->used && record->backend_id != 0 && record->last_used_frame != frame_index &&
+                (oldest == NULL || record->last_used_frame < oldest->last_used_frame)) {
+                oldest = record;
+            }
+        }
+        if (oldest == NULL) {
+            return;
+        }
+        texture_evict(oldest);
+    }
+}
+
+static bool texture_make_resident(GfxTextureRecord* record, int backend_id) {
+    if (backend_id == 0) {
+        return false;
+    }
+    int width = 0;
+    int height = 0;
+    platform_graphics_get_texture_size(backend_id, &width, &height);
+    record->backend_id = backend_id;
+    record->width = width;
+    record->height = height;
+    record->bytes = (size_t)width * (size_t)height * 4;
+    record->last_used_frame = frame_index;
+    texture_stats.resident_bytes += record->bytes;
+    texture_stats.resident_count++;
+    return true;
+}
+
+// Backend ID for a draw, or 0 if the texture isn't resident. Marks the
+// texture as used this frame, and queues a reload when it was evicted.
+static int texture_use(int texture_id) {
+    GfxTextureRecord* record = texture_record(texture_id);
+    if (record == NULL) {
+        return 0;
+    }
+    record->last_used_frame = frame_index;
+    if (record->backend_id == 0 && !record->reload_requested && record->path[0] != '\0') {
+        record->reload_requested = true;
+        texture_stats.pending_reloads++;
+    }
+    return record->backend_id;
+}
+
+// Runs at the start of a frame, before anything is batched. Queued reloads
+// start their file read on the loader thread; reads that have finished are
+// decoded and uploaded here, a few per frame, so the main thread never
+// waits on the disk and a burst of reloads is spread over several frames.
+static void texture_service_reloads(void) {
+    int uploads = GFX_TEXTURE_RELOADS_PER_FRAME;
+    for (int i = 0; i < GFX_MAX_TEXTURES && texture_stats.pending_reloads > 0; i++) {
+        GfxTextureRecord* record = &texture_records[i];
+        if (!record->used || !record->reload_requested) {
+            continue;
+        }
+        if (!record->reading) {
+            // All loader requests busy: try again next frame
+            record->read_request = loader_read(record->path);
+            record->reading = record->read_request >= 0;
+            continue;
+        }
+        if (uploads == 0) {
+            continue;
+        }
+
+        unsigned char* data = NULL;
+        size_t size = 0;
+        LoaderStatus status = loader_poll(record->read_request, &data, &size);
+        if (status == LOADER_PENDING) {
+            continue;
+        }
+        record->reading = false;
+        record->reload_requested = false;
+        texture_stats.pending_reloads--;
+        bool resident = false;
+        if (status == LOADER_DONE) {
+            uploads--;
+            texture_enforce_budget(record->bytes);
+            resident = texture_make_resident(
+                record, platform_graphics_load_texture_memory(record->path, data, size, record->premultiplied));
+            loader_free(data, size);
+        }
+        if (resident) {
+            texture_stats.reloads++;
+        } else {
+            // Don't retry every frame for a file that has gone away
+            record->path[0] = '\0';
+        }
+    }
+}
+
+static int texture_load(const char* filename, bool premultiplied) {
+    int slot = 0;
+    while (slot < GFX_MAX_TEXTURES && texture_records[slot].used) {
+        slot++;
+    }
+    if (slot == GFX_MAX_TEXTURES) {
+        return 0;
+    }
+
+    GfxTextureRecord* record = &texture_records[slot];
+    memset(record, 0, sizeof(*record));
+    record->premultiplied = premultiplied;
+    size_t length = filename ? strlen(filename) : 0;
+    if (length == 0 || length >= GFX_TEXTURE_PATH_MAX) {
+        return 0;
+    }
+    memcpy(record->path, filename, length);
+    // Size is only known once loaded, so the budget is settled afterwards
+    if (!texture_make_resident(record, platform_graphics_load_texture(record->path, premultiplied))) {
+        return 0;
+    }
+    record->used = true;
+    texture_enforce_budget(0);
+    return slot + 1;
+}
+
+void graphics_set_window_flags(unsigned int flags) {
+    window_flags = flags;
+}
 
 void graphics_init(int width, int height, const char* title, GraphicsBackend backend) {
     current_backend = backend;
-    platform_graphics_init(width, height, title);
+    platform_graphics_init(width, height, title, window_flags);
+    platform_graphics_set_blend_mode(GFX_BLEND_ALPHA);
+    backend_blend_mode = GFX_BLEND_ALPHA;
 }
 
 void graphics_shutdown(void) {
+    for (int i = 0; i < GFX_MAX_TEXTURES; i++) {
+        if (texture_records[i].used) {
+            graphics_unload_texture(i + 1);
+        }
+    }
+    mem_free(view_scratch);
+    view_scratch = NULL;
+    view_scratch_capacity = 0;
     platform_graphics_shutdown();
 }
 
@@ -29,33 +438,474 @@ bool graphics_should_close(void) {
 }
 
 void graphics_begin_frame(void) {
+    frame_index++;
     platform_graphics_begin_frame();
+    texture_service_reloads();
 }
 
 void graphics_end_frame(void) {
+    graphics_flush();
+    last_frame_stats = frame_stats;
+    memset(&frame_stats, 0, sizeof(frame_stats));
+    // An unbalanced push shouldn't leak into the next frame
+    clip_overflow = 0;
+    if (clip_depth > 0) {
+        clip_depth = 0;
+        platform_graphics_set_clip(NULL);
+    }
     platform_graphics_end_frame();
 }
 
 void graphics_clear(GfxColor color) {
+    // Anything recorded before a clear would be wiped anyway
+    batch.vertex_count = 0;
+    batch.index_count = 0;
+    batch.view_start = 0;
     platform_graphics_clear(color);
 }
 
 void graphics_draw_rectangle(GfxRectangle rect, GfxColor color) {
-    platform_graphics_draw_rectangle(rect, color);
+    if (clip_rejects_rect(rect)) {
+        return;
+    }
+    float x1 = rect.x + rect.width;
+    float y1 = rect.y + rect.height;
+    GfxVertex quad[4] = {
+        {rect.x, rect.y, 0.0f, 0.0f, color},
+        {x1, rect.y, 0.0f, 0.0f, color},
+        {x1, y1, 0.0f, 0.0f, color},
+        {rect.x, y1, 0.0f, 0.0f, color},
+    };
+    batch_quad(0, quad);
+}
+
+void graphics_draw_line(float x0, float y0, float x1, float y1, float thickness, GfxColor color) {
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    float len = sqrtf(dx * dx + dy * dy);
+    if (len <= 0.0f) {
+        return;
+    }
+    float nx = -dy / len * thickness * 0.5f;
+    float ny = dx / len * thickness * 0.5f;
+    GfxVertex quad[4] = {
+        {x0 + nx, y0 + ny, 0.0f, 0.0f, color},
+        {x1 + nx, y1 + ny, 0.0f, 0.0f, color},
+        {x1 - nx, y1 - ny, 0.0f, 0.0f, color},
+        {x0 - nx, y0 - ny, 0.0f, 0.0f, color},
+    };
+    if (clip_rejects_vertices(quad, 4)) {
+        return;
+    }
+    batch_quad(0, quad);
+}
+
+void graphics_draw_circle(float center_x, float center_y, float radius, GfxColor color) {
+    if (clip_rejects(center_x - radius, center_y - radius, center_x + radius, center_y + radius)) {
+        return;
+    }
+    int segments = circle_segments(radius);
+    const GfxCircleTable* table = circle_table(segments);
+    int base = batch_reserve(0, segments + 1, segments * 3);
+    GfxVertex* v = &batch.vertices[base];
+
+    // Fan from the first rim point, the circle is convex so no center vertex is needed
+    for (int i = 0; i < segments; i++) {
+        v[i] = (GfxVertex){center_x + table->cos_table[i] * radius, center_y + table->sin_table[i] * radius, 0.0f,
+                           0.0f, color};
+    }
+    batch_fan(base, segments);
+}
+
+void graphics_draw_rounded_rectangle(GfxRectangle rect, float radius, GfxColor color) {
+    float max_radius = (rect.width < rect.height ? rect.width : rect.height) * 0.5f;
+    if (radius > max_radius) {
+        radius = max_radius;
+    }
+    if (radius <= 0.0f) {
+        graphics_draw_rectangle(rect, color);
+        return;
+    }
+    if (clip_rejects_rect(rect)) {
+        return;
+    }
+
+    int segments = circle_segments(radius);
+    int quarter = segments / 4;
+    const GfxCircleTable* table = circle_table(segments);
+    int count = (quarter + 1) * 4;
+    int base = batch_reserve(0, count, (count - 2) * 3);
+    GfxVertex* v = &batch.vertices[base];
+
+    // Corner centers in table order: bottom-right, bottom-left, top-left, top-right
+    float cx[4] = {rect.x + rect.width - radius, rect.x + radius, rect.x + radius, rect.x + rect.width - radius};
+    float cy[4] = {rect.y + rect.height - radius, rect.y + rect.height - radius, rect.y + radius, rect.y + radius};
+    for (int corner = 0; corner < 4; corner++) {
+        for (int i = 0; i <= quarter; i++) {
+            int t = corner * quarter + i;
+            *v++ = (GfxVertex){cx[corner] + table->cos_table[t] * radius, cy[corner] + table->sin_table[t] * radius,
+                               0.0f, 0.0f, color};
+        }
+    }
+    batch_fan(base, count);
+}
+
+void graphics_draw_polygon(const GfxVector2* points, int count, GfxColor color) {
+    if (count < 3 || count > GFX_BATCH_MAX_VERTICES / 2) {
+        return;
+    }
+    int base = batch_reserve(0, count, (count - 2) * 3);
+    GfxVertex* v = &batch.vertices[base];
+    for (int i = 0; i < count; i++) {
+        v[i] = (GfxVertex){points[i].x, points[i].y, 0.0f, 0.0f, color};
+    }
+    // Written in place, so a rejected polygon is dropped by not committing it
+    if (clip_rejects_vertices(v, count)) {
+        return;
+    }
+    batch_fan(base, count);
+}
+
+// Corner positions of a transformed sprite, in quad order (top-left,
+// top-right, bottom-right, bottom-left). With SSE2 the four corners are
+// transformed together, one per lane.
+static void sprite_corners(const GfxSprite* s, float cos_r, float sin_r, float* out_x, float* out_y) {
+    float left = -s->origin_x * s->scale_x;
+    float right = (s->width - s->origin_x) * s->scale_x;
+    float top = -s->origin_y * s->scale_y;
+    float bottom = (s->height - s->origin_y) * s->scale_y;
+
+#if defined(__SSE2__)
+    __m128 lx = _mm_setr_ps(left, right, right, left);
+    __m128 ly = _mm_setr_ps(top, top, bottom, bottom);
+    __m128 c = _mm_set1_ps(cos_r);
+    __m128 sn = _mm_set1_ps(sin_r);
+    __m128 x = _mm_add_ps(_mm_set1_ps(s->x), _mm_sub_ps(_mm_mul_ps(lx, c), _mm_mul_ps(ly, sn)));
+    __m128 y = _mm_add_ps(_mm_set1_ps(s->y), _mm_add_ps(_mm_mul_ps(lx, sn), _mm_mul_ps(ly, c)));
+    _mm_storeu_ps(out_x, x);
+    _mm_storeu_ps(out_y, y);
+#else
+    float lx[4] = {left, right, right, left};
+    float ly[4] = {top, top, bottom, bottom};
+    for (int i = 0; i < 4; i++) {
+        out_x[i] = s->x + lx[i] * cos_r - ly[i] * sin_r;
+        out_y[i] = s->y + lx[i] * sin_r + ly[i] * cos_r;
+    }
+#endif
+}
+
+void graphics_draw_sprite(int texture_id, GfxSprite sprite) {
+    graphics_draw_sprites(texture_id, &sprite, 1);
+}
+
+void graphics_draw_sprites(int texture_id, const GfxSprite* sprites, int count) {
+    int tex_w = 1;
+    int tex_h = 1;
+    if (!graphics_get_texture_size(texture_id, &tex_w, &tex_h) || tex_w <= 0 || tex_h <= 0) {
+        return;
+    }
+    int backend_id = texture_use(texture_id);
+    if (backend_id == 0) {
+        return;
+    }
+    float inv_w = 1.0f / (float)tex_w;
+    float inv_h = 1.0f / (float)tex_h;
+
+    for (int i = 0; i < count; i++) {
+        const GfxSprite* s = &sprites[i];
+        float cos_r = 1.0f;
+        float sin_r = 0.0f;
+        if (s->rotation != 0.0f) {
+            cos_r = cosf(s->rotation);
+            sin_r = sinf(s->rotation);
+        }
+
+        float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+        if (s->source.width != 0.0f && s->source.height != 0.0f) {
+            u0 = s->source.x * inv_w;
+            v0 = s->source.y * inv_h;
+            u1 = (s->source.x + s->source.width) * inv_w;
+            v1 = (s->source.y + s->source.height) * inv_h;
+        }
+
+        float x[4], y[4];
+        sprite_corners(s, cos_r, sin_r, x, y);
+        GfxVertex quad[4] = {
+            {x[0], y[0], u0, v0, s->tint},
+            {x[1], y[1], u1, v0, s->tint},
+            {x[2], y[2], u1, v1, s->tint},
+            {x[3], y[3], u0, v1, s->tint},
+        };
+        if (clip_rejects_vertices(quad, 4)) {
+            continue;
+        }
+        batch_quad(backend_id, quad);
+    }
 }
 
 void graphics_draw_texture(int texture_id, GfxRectangle dest, GfxColor tint) {
-    platform_graphics_draw_texture(texture_id, dest, tint);
+    if (clip_rejects_rect(dest)) {
+        return;
+    }
+    int backend_id = texture_use(texture_id);
+    if (backend_id == 0) {
+        return;
+    }
+    graphics_flush();
+    apply_blend_mode(current_blend_mode);
+    if (view.active) {
+        view_to_screen(&dest.x, &dest.y);
+        dest.width *= view.zoom;
+        dest.height *= view.zoom;
+    }
+    platform_graphics_draw_texture(backend_id, dest, tint);
+    frame_stats.draw_calls++;
+}
+
+static void view_text(int* x, int* y, int* size) {
+    if (view.active) {
+        float fx = (float)*x;
+        float fy = (float)*y;
+        view_to_screen(&fx, &fy);
+        *x = (int)fx;
+        *y = (int)fy;
+        *size = (int)((float)*size * view.zoom + 0.5f);
+    }
 }
 
 void graphics_draw_text(const char* text, int x, int y, int size, GfxColor color) {
+    // Width is unknown without measuring, so text is only culled vertically
+    if (clip_rejects(-INFINITY, (float)y, INFINITY, (float)(y + size))) {
+        return;
+    }
+    graphics_flush();
+    view_text(&x, &y, &size);
     platform_graphics_draw_text(text, x, y, size, color);
+    frame_stats.draw_calls++;
 }
 
 int graphics_load_texture(const char* filename) {
-    return platform_graphics_load_texture(filename);
+    return texture_load(filename, false);
+}
+
+// Premultiplies color by alpha once at load, so the texture can be drawn
+// with GFX_BLEND_PREMULTIPLIED and filtered without dark fringes
+int graphics_load_texture_premultiplied(const char* filename) {
+    return texture_load(filename, true);
+}
+
+void graphics_set_blend_mode(GfxBlendMode mode) {
+    // The batch picks this up as part of its key on the next draw
+    current_blend_mode = mode;
+}
+
+GfxBlendMode graphics_get_blend_mode(void) {
+    return current_blend_mode;
+}
+
+GfxColor graphics_color_premultiply(GfxColor color) {
+    return (GfxColor){
+        (unsigned char)((color.r * color.a + 127) / 255),
+        (unsigned char)((color.g * color.a + 127) / 255),
+        (unsigned char)((color.b * color.a + 127) / 255),
+        color.a,
+    };
 }
 
 void graphics_unload_texture(int texture_id) {
-    platform_graphics_unload_texture(texture_id);
+    GfxTextureRecord* record = texture_record(texture_id);
+    if (record == NULL) {
+        return;
+    }
+    if (record->backend_id != 0) {
+        // Queued quads may still reference it
+        graphics_flush();
+        platform_graphics_unload_texture(record->backend_id);
+        texture_stats.resident_bytes -= record->bytes;
+        texture_stats.resident_count--;
+    }
+    if (record->reading) {
+        loader_cancel(record->read_request);
+    }
+    if (record->reload_requested) {
+        texture_stats.pending_reloads--;
+    }
+    memset(record, 0, sizeof(*record));
+}
+
+// Known even while the texture is evicted, so layout doesn't change when it is
+bool graphics_get_texture_size(int texture_id, int* width, int* height) {
+    const GfxTextureRecord* record = texture_record(texture_id);
+    if (record == NULL) {
+        return false;
+    }
+    *width = record->width;
+    *height = record->height;
+    return true;
+}
+
+void graphics_set_texture_budget(size_t bytes) {
+    texture_budget = bytes;
+    texture_enforce_budget(0);
+}
+
+GfxTextureStats graphics_get_texture_stats(void) {
+    GfxTextureStats stats = texture_stats;
+    stats.budget_bytes = texture_budget;
+    return stats;
+}
+
+GfxFrameStats graphics_get_frame_stats(void) {
+    return last_frame_stats;
+}
+
+double graphics_get_time(void) {
+    return platform_graphics_get_time();
+}
+
+void graphics_draw_geometry(int texture_id, const GfxVertex* vertices, int vertex_count, const int* indices,
+                            int index_count) {
+    if (vertex_count <= 0 || (indices != NULL && index_count <= 0)) {
+        return;
+    }
+    if (indices == NULL) {
+        index_count = vertex_count - vertex_count % 3;
+    }
+    if (clip_rejects_vertices(vertices, vertex_count)) {
+        return;
+    }
+    int backend_id = 0;
+    if (texture_id != 0) {
+        // Evicted textures skip the draw rather than falling back to untextured
+        backend_id = texture_use(texture_id);
+        if (backend_id == 0) {
+            return;
+        }
+    }
+
+    // Meshes too big for the batch go straight out, after whatever is queued
+    if (vertex_count > GFX_BATCH_MAX_VERTICES / 2 || index_count > GFX_BATCH_MAX_INDICES / 2) {
+        graphics_flush();
+        apply_blend_mode(current_blend_mode);
+        if (view.active) {
+            if (vertex_count > view_scratch_capacity) {
+                GfxVertex* grown =
+                    mem_realloc(MEM_TAG_GRAPHICS, view_scratch, (size_t)vertex_count * sizeof(GfxVertex));
+                if (grown == NULL) {
+                    return;
+                }
+                view_scratch = grown;
+                view_scratch_capacity = vertex_count;
+            }
+            memcpy(view_scratch, vertices, (size_t)vertex_count * sizeof(GfxVertex));
+            view_apply(view_scratch, vertex_count);
+            vertices = view_scratch;
+        }
+        platform_graphics_draw_geometry(backend_id, vertices, vertex_count, indices, index_count);
+        frame_stats.draw_calls++;
+        frame_stats.vertices += vertex_count;
+        return;
+    }
+
+    int base = batch_reserve(backend_id, vertex_count, index_count);
+    int* idx = &batch.indices[batch.index_count];
+    memcpy(&batch.vertices[base], vertices, (size_t)vertex_count * sizeof(GfxVertex));
+    for (int i = 0; i < index_count; i++) {
+        idx[i] = base + (indices ? indices[i] : i);
+    }
+    batch.vertex_count += vertex_count;
+    batch.index_count += index_count;
+}
+
+void graphics_set_view(float offset_x, float offset_y, float zoom) {
+    // Vertices already recorded belong to the previous view
+    batch_apply_view();
+    view = (GfxView){true, offset_x, offset_y, zoom > 0.0f ? zoom : 1.0f};
+}
+
+void graphics_reset_view(void) {
+    batch_apply_view();
+    view = (GfxView){false, 0.0f, 0.0f, 1.0f};
+}
+
+void graphics_push_clip(GfxRectangle rect) {
+    if (clip_depth == GFX_CLIP_STACK_MAX) {
+        clip_overflow++;
+        return;
+    }
+    if (clip_depth > 0) {
+        const GfxRectangle* top = &clip_stack[clip_depth - 1];
+        float x0 = rect.x > top->x ? rect.x : top->x;
+        float y0 = rect.y > top->y ? rect.y : top->y;
+        float x1 = rect.x + rect.width < top->x + top->width ? rect.x + rect.width : top->x + top->width;
+        float y1 = rect.y + rect.height < top->y + top->height ? rect.y + rect.height : top->y + top->height;
+        rect = (GfxRectangle){x0, y0, x1 > x0 ? x1 - x0 : 0.0f, y1 > y0 ? y1 - y0 : 0.0f};
+    }
+
+    graphics_flush();
+    clip_stack[clip_depth++] = rect;
+    platform_graphics_set_clip(&rect);
+}
+
+void graphics_pop_clip(void) {
+    if (clip_overflow > 0) {
+        clip_overflow--;
+        return;
+    }
+    if (clip_depth == 0) {
+        return;
+    }
+    graphics_flush();
+    clip_depth--;
+    platform_graphics_set_clip(clip_depth > 0 ? &clip_stack[clip_depth - 1] : NULL);
+}
+
+GfxStringView graphics_string_view(const char* text) {
+    return graphics_string_view_n(text, text ? (int)strlen(text) : 0);
+}
+
+GfxStringView graphics_string_view_n(const char* data, int length) {
+    return (GfxStringView){data, length, 0};
+}
+
+// FNV-1a, never returns 0 so that 0 can mean "not computed"
+unsigned int graphics_string_hash(const char* data, int length) {
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < length; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 16777619u;
+    }
+    return hash ? hash : 1u;
+}
+
+void graphics_draw_text_view(GfxStringView text, int x, int y, int size, GfxColor color) {
+    if (text.length <= 0 || clip_rejects(-INFINITY, (float)y, INFINITY, (float)(y + size))) {
+        return;
+    }
+    graphics_flush();
+    view_text(&x, &y, &size);
+    platform_graphics_draw_text_view(text.data, text.length, x, y, size, color);
+    frame_stats.draw_calls++;
+}
+
+// Hashes the view on first use and stores the hash back into it, so callers
+// that keep their views around only pay for the scan once
+int graphics_measure_text_view(GfxStringView* text, int size) {
+    if (text->length <= 0) {
+        return 0;
+    }
+    if (text->hash == 0) {
+        text->hash = graphics_string_hash(text->data, text->length);
+    }
+
+    TextMeasureEntry* entry = &text_measure_cache[(text->hash ^ (unsigned int)size) % TEXT_MEASURE_CACHE_SIZE];
+    if (entry->hash == text->hash && entry->length == text->length && entry->size == size) {
+        return entry->width;
+    }
+
+    entry->hash = text->hash;
+    entry->length = text->length;
+    entry->size = size;
+    entry->width = platform_graphics_measure_text_view(text->data, text->length, size);
+    return entry->width;
 }
\ No newline at end of file
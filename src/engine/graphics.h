@@ -2,13 +2,25 @@
 #define GRAPHICS_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 // Core graphics interface
 typedef enum {
     GRAPHICS_RAYLIB,
-    GRAPHICS_SDL3
+    GRAPHICS_SDL3,
+    GRAPHICS_NULL  // headless, nothing is drawn
 } GraphicsBackend;
 
+// Part of the batch key: switching mode costs a flush, so group draws by mode.
+// PREMULTIPLIED expects textures loaded with graphics_load_texture_premultiplied
+// and tints passed through graphics_color_premultiply.
+typedef enum {
+    GFX_BLEND_ALPHA,
+    GFX_BLEND_PREMULTIPLIED,
+    GFX_BLEND_ADDITIVE,
+    GFX_BLEND_MULTIPLY
+} GfxBlendMode;
+
 typedef struct {
     float x, y, width, height;
 } GfxRectangle;
@@ -17,6 +29,59 @@ typedef struct {
     unsigned char r, g, b, a;
 } GfxColor;
 
+typedef struct {
+    float x, y;
+} GfxVector2;
+
+// Vertex for textured triangle lists, uv normalized to the texture size
+typedef struct {
+    float x, y;
+    float u, v;
+    GfxColor color;
+} GfxVertex;
+
+// Textured quad with an affine transform. The quad is width x height,
+// scaled and rotated around origin (in unscaled quad units, 0,0 = top-left)
+// and placed so that the origin lands on (x, y).
+typedef struct {
+    GfxRectangle source;  // pixels in the texture, zero size = whole texture
+    float x, y;
+    float width, height;
+    float origin_x, origin_y;
+    float scale_x, scale_y;
+    float rotation;  // radians, clockwise on screen
+    GfxColor tint;
+} GfxSprite;
+
+// Length-delimited text, so strings can be drawn straight out of larger
+// buffers without a NUL terminator. hash is optional (0 = not computed yet)
+// and lets text measurement be cached across frames.
+typedef struct {
+    const char* data;
+    int length;
+    unsigned int hash;
+} GfxStringView;
+
+// Texture residency, see graphics_set_texture_budget
+typedef struct {
+    size_t resident_bytes;  // width * height * 4 for each loaded texture
+    size_t budget_bytes;    // 0 = unlimited
+    int resident_count;
+    int pending_reloads;
+    unsigned int evictions;  // running totals
+    unsigned int reloads;
+} GfxTextureStats;
+
+// Counters for the last completed frame
+typedef struct {
+    int draw_calls;  // backend submissions, batch flushes included
+    int vertices;
+    int culled;  // draws dropped by the clip rect
+} GfxFrameStats;
+
+// String view over a literal, length known at compile time
+#define GFX_STRING(literal) (GfxStringView){(literal), (int)sizeof(literal) - 1, 0}
+
 // Predefined colors
 #define COLOR_WHITE     (GfxColor){255, 255, 255, 255}
 #define COLOR_BLACK     (GfxColor){0, 0, 0, 255}
@@ -25,6 +90,14 @@ typedef struct {
 #define COLOR_BLUE      (GfxColor){0, 0, 255, 255}
 #define COLOR_GRAY      (GfxColor){128, 128, 128, 255}
 
+// Window flags, set with graphics_set_window_flags before graphics_init
+enum {
+    GFX_WINDOW_HIDDEN = 1 << 0,    // no visible window, for headless runs on a windowed backend
+    GFX_WINDOW_UNCAPPED = 1 << 1,  // no vsync or frame rate cap
+};
+
+void graphics_set_window_flags(unsigned int flags);
+
 // Essential functions
 void graphics_init(int width, int height, const char* title, GraphicsBackend backend);
 void graphics_shutdown(void);
@@ -36,6 +109,60 @@ void graphics_draw_rectangle(GfxRectangle rect, GfxColor color);
 void graphics_draw_texture(int texture_id, GfxRectangle dest, GfxColor tint);
 void graphics_draw_text(const char* text, int x, int y, int size, GfxColor color);
 int graphics_load_texture(const char* filename);
+int graphics_load_texture_premultiplied(const char* filename);
 void graphics_unload_texture(int texture_id);
+bool graphics_get_texture_size(int texture_id, int* width, int* height);
+
+// Caps the memory held by loaded textures. Over budget, the least recently
+// drawn textures are evicted; their handles stay valid and the next draw
+// queues a reload from the original file. The file is read in the
+// background (loader.h) and uploaded at the start of a later frame; draws
+// of the texture are skipped until then.
+void graphics_set_texture_budget(size_t bytes);
+GfxTextureStats graphics_get_texture_stats(void);
+
+GfxFrameStats graphics_get_frame_stats(void);
+double graphics_get_time(void);  // seconds, monotonic
+
+// Transformed sprites, expanded into the shared batch
+void graphics_draw_sprite(int texture_id, GfxSprite sprite);
+void graphics_draw_sprites(int texture_id, const GfxSprite* sprites, int count);
+
+// Triangle list. texture_id 0 draws untextured; indices may be NULL to use
+// the vertices in order. Small meshes are merged into the shared batch.
+void graphics_draw_geometry(int texture_id, const GfxVertex* vertices, int vertex_count, const int* indices,
+                            int index_count);
+
+// Primitives, tessellated into the shared batch
+void graphics_draw_line(float x0, float y0, float x1, float y1, float thickness, GfxColor color);
+void graphics_draw_circle(float center_x, float center_y, float radius, GfxColor color);
+void graphics_draw_rounded_rectangle(GfxRectangle rect, float radius, GfxColor color);
+void graphics_draw_polygon(const GfxVector2* points, int count, GfxColor color);  // convex, any winding
+
+void graphics_set_blend_mode(GfxBlendMode mode);
+GfxBlendMode graphics_get_blend_mode(void);
+GfxColor graphics_color_premultiply(GfxColor color);
+
+// World-to-screen view for everything drawn until reset:
+// screen = (world - offset) * zoom. Usually driven by the camera module.
+void graphics_set_view(float offset_x, float offset_y, float zoom);
+void graphics_reset_view(void);
+
+// Clip rectangle stack, in screen pixels. A pushed rect is intersected with
+// the current one; draws entirely outside it are dropped on the CPU. The
+// stack is 16 deep; deeper pushes are ignored along with their pops.
+void graphics_push_clip(GfxRectangle rect);
+void graphics_pop_clip(void);
+
+// Submits everything batched so far. Called automatically before unbatched
+// draws and at the end of the frame.
+void graphics_flush(void);
+
+// Text views
+GfxStringView graphics_string_view(const char* text);
+GfxStringView graphics_string_view_n(const char* data, int length);
+unsigned int graphics_string_hash(const char* data, int length);
+void graphics_draw_text_view(GfxStringView text, int x, int y, int size, GfxColor color);
+int graphics_measure_text_view(GfxStringView* text, int size);
 
 #endif // GRAPHICS_H
\ No newline at end of file
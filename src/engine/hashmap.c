@@ -0,0 +1,223 @@
+#include "hashmap.h"
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define CTRL_EMPTY 0x80
+#define CTRL_DELETED 0xFE
+
+// Finalizer from MurmurHash3, spreads key bits over the whole word
+static uint64_t hashmap_mix(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDull;
+    key ^= key >> 33;
+    key *= 0xC4CEB9FE1A85EC53ull;
+    key ^= key >> 33;
+    return key;
+}
+
+uint64_t hashmap_hash_bytes(const void* data, size_t length) {
+    // FNV-1a 64
+    const unsigned char* bytes = data;
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+// Bit i set when slot i of the group holds byte b
+static uint32_t group_match(const uint8_t* group, uint8_t b) {
+#if defined(__SSE2__)
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)b)));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < HASHMAP_GROUP_WIDTH; i++) {
+        mask |= (uint32_t)(group[i] == b) << i;
+    }
+    return mask;
+#endif
+}
+
+// Bit i set when slot i is empty or deleted (high bit set in both)
+static uint32_t group_match_free(const uint8_t* group) {
+#if defined(__SSE2__)
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < HASHMAP_GROUP_WIDTH; i++) {
+        mask |= (uint32_t)(group[i] >> 7) << i;
+    }
+    return mask;
+#endif
+}
+
+static int lowest_bit(uint32_t mask) {
+    return __builtin_ctz(mask);
+}
+
+static void set_ctrl(HashMap* map, uint32_t slot, uint8_t value) {
+    map->ctrl[slot] = value;
+    // Mirror the first group past the end so unaligned group loads wrap
+    if (slot < HASHMAP_GROUP_WIDTH) {
+        map->ctrl[map->capacity + slot] = value;
+    }
+}
+
+bool hashmap_init(HashMap* map, Arena* arena, uint32_t max_entries) {
+    uint32_t capacity = HASHMAP_GROUP_WIDTH;
+    while (capacity - capacity / 8 < max_entries) {
+        capacity *= 2;
+    }
+
+    memset(map, 0, sizeof(*map));
+    map->ctrl = arena_alloc(arena, capacity + HASHMAP_GROUP_WIDTH, ARENA_DEFAULT_ALIGN);
+    map->keys = ARENA_NEW_ARRAY(arena, uint64_t, capacity);
+    map->values = ARENA_NEW_ARRAY(arena, uint32_t, capacity);
+    if (map->ctrl == NULL || map->keys == NULL || map->values == NULL) {
+        return false;
+    }
+    map->capacity = capacity;
+    hashmap_clear(map);
+    return true;
+}
+
+void hashmap_clear(HashMap* map) {
+    memset(map->ctrl, CTRL_EMPTY, map->capacity + HASHMAP_GROUP_WIDTH);
+    map->count = 0;
+    map->tombstones = 0;
+}
+
+// Slot holding key, or -1
+static int64_t hashmap_find(const HashMap* map, uint64_t key) {
+    uint64_t hash = hashmap_mix(key);
+    uint8_t tag = (uint8_t)(hash & 0x7F);
+    uint32_t mask = map->capacity - 1;
+    uint32_t pos = (uint32_t)(hash >> 7) & mask;
+
+    // Triangular probing over groups visits every group once
+    for (uint32_t step = HASHMAP_GROUP_WIDTH; step <= map->capacity + HASHMAP_GROUP_WIDTH;
+         step += HASHMAP_GROUP_WIDTH) {
+        const uint8_t* group = &map->ctrl[pos];
+        for (uint32_t match = group_match(group, tag); match; match &= match - 1) {
+            uint32_t slot = (pos + (uint32_t)lowest_bit(match)) & mask;
+            if (map->keys[slot] == key) {
+                return slot;
+            }
+        }
+        if (group_match(group, CTRL_EMPTY)) {
+            return -1;
+        }
+        pos = (pos + step) & mask;
+    }
+    return -1;
+}
+
+bool hashmap_get(const HashMap* map, uint64_t key, uint32_t* value) {
+    if (map->capacity == 0) {
+        return false;
+    }
+    int64_t slot = hashmap_find(map, key);
+    if (slot < 0) {
+        return false;
+    }
+    *value = map->values[slot];
+    return true;
+}
+
+// First empty or deleted slot on key's probe sequence
+static uint32_t hashmap_find_free(const HashMap* map, uint64_t hash) {
+    uint32_t mask = map->capacity - 1;
+    uint32_t pos = (uint32_t)(hash >> 7) & mask;
+    for (uint32_t step = HASHMAP_GROUP_WIDTH;; step += HASHMAP_GROUP_WIDTH) {
+        uint32_t free_slots = group_match_free(&map->ctrl[pos]);
+        if (free_slots) {
+            return (pos + (uint32_t)lowest_bit(free_slots)) & mask;
+        }
+        pos = (pos + step) & mask;
+    }
+}
+
+// Drops every tombstone without new memory. Live entries are first marked
+// deleted (pending) and tombstones become empty, then each pending entry
+// moves to the first free slot on its probe sequence, swapping with a
+// pending one it lands on. Placed slots are never freed again, so each
+// entry ends up where a fresh insert would have put it.
+static void hashmap_rehash_in_place(HashMap* map) {
+    for (uint32_t i = 0; i < map->capacity; i++) {
+        set_ctrl(map, i, map->ctrl[i] == CTRL_DELETED || map->ctrl[i] == CTRL_EMPTY ? CTRL_EMPTY : CTRL_DELETED);
+    }
+    for (uint32_t i = 0; i < map->capacity; i++) {
+        while (map->ctrl[i] == CTRL_DELETED) {
+            uint64_t hash = hashmap_mix(map->keys[i]);
+            uint32_t target = hashmap_find_free(map, hash);
+            uint8_t target_ctrl = map->ctrl[target];
+            set_ctrl(map, target, (uint8_t)(hash & 0x7F));
+            if (target == i) {
+                break;
+            }
+
+            uint64_t key = map->keys[target];
+            uint32_t value = map->values[target];
+            map->keys[target] = map->keys[i];
+            map->values[target] = map->values[i];
+            if (target_ctrl == CTRL_EMPTY) {
+                set_ctrl(map, i, CTRL_EMPTY);
+            } else {
+                // Target was pending too: its entry is placed next round
+                map->keys[i] = key;
+                map->values[i] = value;
+            }
+        }
+    }
+    map->tombstones = 0;
+}
+
+bool hashmap_put(HashMap* map, uint64_t key, uint32_t value) {
+    if (map->capacity == 0) {
+        return false;
+    }
+    int64_t existing = hashmap_find(map, key);
+    if (existing >= 0) {
+        map->values[existing] = value;
+        return true;
+    }
+    uint32_t limit = map->capacity - map->capacity / 8;
+    if (map->count + map->tombstones >= limit) {
+        // Worth it once tombstones are a sixteenth of the limit, so insert
+        // and remove churn pays for each rehash many times over
+        if (map->count >= limit || map->tombstones < (limit / 16 > 0 ? limit / 16 : 1)) {
+            return false;
+        }
+        hashmap_rehash_in_place(map);
+    }
+
+    uint64_t hash = hashmap_mix(key);
+    uint32_t slot = hashmap_find_free(map, hash);
+    if (map->ctrl[slot] == CTRL_DELETED) {
+        map->tombstones--;
+    }
+    set_ctrl(map, slot, (uint8_t)(hash & 0x7F));
+    map->keys[slot] = key;
+    map->values[slot] = value;
+    map->count++;
+    return true;
+}
+
+bool hashmap_remove(HashMap* map, uint64_t key) {
+    if (map->capacity == 0) {
+        return false;
+    }
+    int64_t slot = hashmap_find(map, key);
+    if (slot < 0) {
+        return false;
+    }
+    set_ctrl(map, (uint32_t)slot, CTRL_DELETED);
+    map->count--;
+    map->tombstones++;
+    return true;
+}
\ No newline at end of file
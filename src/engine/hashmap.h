@@ -0,0 +1,38 @@
+#ifndef HASHMAP_H
+#define HASHMAP_H
+
+#include "arena.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Open-addressing hash map from 64-bit keys to 32-bit values (usually an ID
+// or an index into the caller's own arrays), allocated from an arena.
+//
+// Swiss-table layout: one control byte per slot holding 7 bits of the hash,
+// scanned 16 slots at a time (one SSE2 compare) so most lookups touch a
+// single key. Capacity is fixed at init and kept at most 7/8 full; when
+// removed keys fill that up, the table is rehashed in place.
+
+#define HASHMAP_GROUP_WIDTH 16
+
+typedef struct {
+    uint8_t* ctrl;  // capacity + HASHMAP_GROUP_WIDTH, tail mirrors the head
+    uint64_t* keys;
+    uint32_t* values;
+    uint32_t capacity;  // power of two
+    uint32_t count;
+    uint32_t tombstones;
+} HashMap;
+
+// Room for at least max_entries; returns false if the arena is too small
+bool hashmap_init(HashMap* map, Arena* arena, uint32_t max_entries);
+void hashmap_clear(HashMap* map);
+
+bool hashmap_get(const HashMap* map, uint64_t key, uint32_t* value);
+bool hashmap_put(HashMap* map, uint64_t key, uint32_t value);  // false when full
+bool hashmap_remove(HashMap* map, uint64_t key);
+
+// 64-bit hash of a byte string, for building keys
+uint64_t hashmap_hash_bytes(const void* data, size_t length);
+
+#endif // HASHMAP_H
\ No newline at end of file
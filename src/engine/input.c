@@ -0,0 +1,249 @@
+#include "input.h"
+#include "mem.h"
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// Gesture thresholds, in pixels and seconds
+#define SWIPE_DISTANCE 30.0f
+#define SWIPE_MAX_TIME 0.3
+#define TAP_SLOP 10.0f
+#define TAP_MAX_TIME 0.25
+
+static const char* action_names[INPUT_ACTION_COUNT] = {"jump", "crouch", "pause"};
+
+typedef struct {
+    double sim_time;
+    InputAction action;
+    bool pressed;
+} ReplayEvent;
+
+static struct {
+    InputEvent queue[INPUT_QUEUE_SIZE];
+    int head;
+    int count;
+    unsigned int dropped;
+    // Keys or buttons holding each action, per source: two keys bound to
+    // one action are both counted, so releasing one keeps it held
+    unsigned char held[INPUT_ACTION_COUNT][INPUT_SOURCE_COUNT];
+
+    ReplayEvent* replay;
+    int replay_count;
+    int replay_next;
+
+    // Tracked pointer for gestures
+    struct {
+        bool active;
+        bool swiped;
+        bool crouching;
+        int id;
+        float start_x, start_y;
+        double start_time;
+    } pointer;
+} input;
+
+void input_push(InputAction action, bool pressed, double time, InputSource source) {
+    unsigned char* held = &input.held[action][source];
+    if (pressed && *held < UCHAR_MAX) {
+        (*held)++;
+    } else if (!pressed && *held > 0) {
+        (*held)--;
+    }
+
+    if (input.count == INPUT_QUEUE_SIZE) {
+        input.dropped++;
+        return;
+    }
+    input.queue[(input.head + input.count) % INPUT_QUEUE_SIZE] = (InputEvent){time, action, source, pressed};
+    input.count++;
+}
+
+bool input_pop(double until, InputEvent* event) {
+    if (input.count == 0) {
+        return false;
+    }
+
+    // Sources are pushed in batches, so the oldest isn't always at the head
+    int oldest = 0;
+    for (int i = 1; i < input.count; i++) {
+        if (input.queue[(input.head + i) % INPUT_QUEUE_SIZE].time <
+            input.queue[(input.head + oldest) % INPUT_QUEUE_SIZE].time) {
+            oldest = i;
+        }
+    }
+    int slot = (input.head + oldest) % INPUT_QUEUE_SIZE;
+    if (input.queue[slot].time > until) {
+        return false;
+    }
+
+    *event = input.queue[slot];
+    for (int i = oldest; i > 0; i--) {
+        input.queue[(input.head + i) % INPUT_QUEUE_SIZE] = input.queue[(input.head + i - 1) % INPUT_QUEUE_SIZE];
+    }
+    input.head = (input.head + 1) % INPUT_QUEUE_SIZE;
+    input.count--;
+    return true;
+}
+
+void input_clear(void) {
+    input.head = 0;
+    input.count = 0;
+}
+
+bool input_is_down(InputAction action) {
+    for (int source = 0; source < INPUT_SOURCE_COUNT; source++) {
+        if (input.held[action][source] > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+unsigned int input_dropped_events(void) {
+    return input.dropped;
+}
+
+static void push_tap(InputAction action, double time) {
+    input_push(action, true, time, INPUT_SOURCE_TOUCH);
+    input_push(action, false, time, INPUT_SOURCE_TOUCH);
+}
+
+void input_pointer(InputPointerPhase phase, int pointer_id, float x, float y, double time) {
+    if (phase == INPUT_POINTER_DOWN) {
+        if (!input.pointer.active) {
+            input.pointer.active = true;
+            input.pointer.swiped = false;
+            input.pointer.crouching = false;
+            input.pointer.id = pointer_id;
+            input.pointer.start_x = x;
+            input.pointer.start_y = y;
+            input.pointer.start_time = time;
+        }
+        return;
+    }
+    if (!input.pointer.active || pointer_id != input.pointer.id) {
+        return;
+    }
+
+    float dx = x - input.pointer.start_x;
+    float dy = y - input.pointer.start_y;
+    double held = time - input.pointer.start_time;
+
+    if (phase == INPUT_POINTER_MOVE) {
+        // Mostly vertical, far enough and quick enough
+        if (!input.pointer.swiped && fabsf(dy) >= SWIPE_DISTANCE && fabsf(dy) > fabsf(dx) && held <= SWIPE_MAX_TIME) {
+            input.pointer.swiped = true;
+            if (dy > 0.0f) {
+                input.pointer.crouching = true;
+                input_push(INPUT_ACTION_CROUCH, true, time, INPUT_SOURCE_TOUCH);
+            } else {
+                push_tap(INPUT_ACTION_JUMP, time);
+            }
+        }
+        return;
+    }
+
+    if (input.pointer.crouching) {
+        input_push(INPUT_ACTION_CROUCH, false, time, INPUT_SOURCE_TOUCH);
+    } else if (phase == INPUT_POINTER_UP && !input.pointer.swiped && dx * dx + dy * dy <= TAP_SLOP * TAP_SLOP &&
+               held <= TAP_MAX_TIME) {
+        push_tap(INPUT_ACTION_JUMP, time);
+    }
+    input.pointer.active = false;
+}
+
+bool input_load_replay(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        return false;
+    }
+
+    mem_free(input.replay);
+    input.replay = NULL;
+    input.replay_count = 0;
+    input.replay_next = 0;
+    int capacity = 0;
+
+    // Line by line, so a truncated last line can't pass as the end of file
+    char text[128];
+    double previous = 0.0;
+    int line = 0;
+    bool ok = true;
+    while (ok && fgets(text, sizeof(text), file) != NULL) {
+        line++;
+        size_t length = strlen(text);
+        if (length + 1 == sizeof(text) && text[length - 1] != '\n' && !feof(file)) {
+            fprintf(stderr, "%s:%d: line too long\n", path, line);
+            ok = false;
+            break;
+        }
+        char blank;
+        if (sscanf(text, " %c", &blank) != 1) {
+            continue;
+        }
+
+        double time;
+        char action[32], state[8];
+        int consumed = 0;
+        int index = 0;
+        bool parsed = sscanf(text, "%lf %31s %7s %n", &time, action, state, &consumed) == 3 && text[consumed] == '\0';
+        while (parsed && index < INPUT_ACTION_COUNT && strcmp(action, action_names[index]) != 0) {
+            index++;
+        }
+        bool down = parsed && strcmp(state, "down") == 0;
+        if (!parsed || index == INPUT_ACTION_COUNT || (!down && strcmp(state, "up") != 0)) {
+            fprintf(stderr, "%s:%d: expected \"<seconds> <action> <down|up>\"\n", path, line);
+            ok = false;
+            break;
+        }
+        // input_replay_update stops at the first event that isn't due yet
+        if (!(time >= previous)) {
+            fprintf(stderr, "%s:%d: time %g is before the previous event (%g)\n", path, line, time, previous);
+            ok = false;
+            break;
+        }
+        previous = time;
+
+        if (input.replay_count == capacity) {
+            capacity = capacity ? capacity * 2 : 64;
+            ReplayEvent* grown = mem_realloc(MEM_TAG_GAMEPLAY, input.replay, (size_t)capacity * sizeof(ReplayEvent));
+            if (grown == NULL) {
+                ok = false;
+                break;
+            }
+            input.replay = grown;
+        }
+        input.replay[input.replay_count++] = (ReplayEvent){time, (InputAction)index, down};
+    }
+    if (ok && ferror(file)) {
+        fprintf(stderr, "%s: read error\n", path);
+        ok = false;
+    }
+    if (!ok) {
+        mem_free(input.replay);
+        input.replay = NULL;
+        input.replay_count = 0;
+    }
+    fclose(file);
+    return ok;
+}
+
+void input_replay_update(double sim_seconds, double now) {
+    while (input.replay_next < input.replay_count && input.replay[input.replay_next].sim_time <= sim_seconds) {
+        const ReplayEvent* event = &input.replay[input.replay_next++];
+        input_push(event->action, event->pressed, now, INPUT_SOURCE_REPLAY);
+    }
+}
+
+void input_shutdown(void) {
+    mem_free(input.replay);
+    input.replay = NULL;
+    input.replay_count = 0;
+    input.replay_next = 0;
+    input_clear();
+}
+
+const char* input_action_name(InputAction action) {
+    return action >= 0 && action < INPUT_ACTION_COUNT ? action_names[action] : "unknown";
+}
\ No newline at end of file
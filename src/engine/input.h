@@ -0,0 +1,75 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdbool.h>
+
+// Timestamped input queue. Backends push action presses and releases as
+// they see them, stamped on the graphics_get_time clock (on SDL3 with the
+// event's own timestamp, so presses between frames keep their sub-frame
+// time). The simulation pops them per tick with input_pop, which only
+// hands out events up to the tick's end time, so a press lands in the tick
+// it happened in rather than at the start of the next frame.
+
+#define INPUT_QUEUE_SIZE 256
+
+typedef enum {
+    INPUT_ACTION_JUMP,
+    INPUT_ACTION_CROUCH,
+    INPUT_ACTION_PAUSE,
+    INPUT_ACTION_COUNT
+} InputAction;
+
+typedef enum {
+    INPUT_SOURCE_KEYBOARD,
+    INPUT_SOURCE_GAMEPAD,
+    INPUT_SOURCE_TOUCH,
+    INPUT_SOURCE_REPLAY,
+    INPUT_SOURCE_COUNT
+} InputSource;
+
+typedef struct {
+    double time;  // seconds, graphics_get_time clock
+    InputAction action;
+    InputSource source;
+    bool pressed;  // false = released
+} InputEvent;
+
+// Called by the backends; events past a full queue are dropped and counted
+void input_push(InputAction action, bool pressed, double time, InputSource source);
+
+// Oldest queued event with time <= until; false if there is none
+bool input_pop(double until, InputEvent* event);
+void input_clear(void);
+
+// Held by any source, as of the last event pushed
+bool input_is_down(InputAction action);
+unsigned int input_dropped_events(void);
+
+// Pointer samples (touch screens, the web build's pointer events) go
+// through gesture recognition: a tap jumps, a swipe up jumps and a swipe
+// down crouches until the finger lifts. Swipes fire on the first sample
+// past the threshold, stamped with that sample's time, so with coalesced
+// samples they're detected within the tick they happen in. Only the first
+// pointer down is tracked; coordinates are in screen pixels.
+typedef enum {
+    INPUT_POINTER_DOWN,
+    INPUT_POINTER_MOVE,
+    INPUT_POINTER_UP,
+    INPUT_POINTER_CANCEL
+} InputPointerPhase;
+
+void input_pointer(InputPointerPhase phase, int pointer_id, float x, float y, double time);
+
+// Replay files: one event per line, "<seconds> <action> <down|up>", with
+// seconds of simulated time since the start of the run, e.g. "1.25 jump
+// down", in non-decreasing order. Blank lines are skipped; anything else
+// that doesn't parse, a truncated last line included, fails the load.
+// input_replay_update pushes every event that is due.
+bool input_load_replay(const char* path);
+void input_replay_update(double sim_seconds, double now);
+
+void input_shutdown(void);  // frees the replay
+
+const char* input_action_name(InputAction action);
+
+#endif // INPUT_H
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "intern.h"
+#include <string.h>
+
+// Probe limit for the (astronomically unlikely) case of two different
+// strings sharing a 64-bit hash
+#define INTERN_MAX_COLLISIONS 4
+
+bool interner_init(StringInterner* interner, Arena* arena, uint32_t max_strings) {
+    memset(interner, 0, sizeof(*interner));
+    interner->arena = arena;
+    interner->strings = ARENA_NEW_ARRAY(arena, const char*, max_strings + 1);
+    interner->lengths = ARENA_NEW_ARRAY(arena, int, max_strings + 1);
+    if (interner->strings == NULL || interner->lengths == NULL || !hashmap_init(&interner->map, arena, max_strings)) {
+        return false;
+    }
+    interner->capacity = max_strings;
+    return true;
+}
+
+static bool interner_matches(const StringInterner* interner, uint32_t id, const char* data, int length) {
+    return interner->lengths[id] == length && memcmp(interner->strings[id], data, (size_t)length) == 0;
+}
+
+// Finds the ID for a string; otherwise reports the key it should be stored
+// under through free_key and returns INTERN_INVALID
+static uint32_t interner_lookup(const StringInterner* interner, const char* data, int length, uint64_t* free_key,
+                                bool* has_free_key) {
+    uint64_t key = hashmap_hash_bytes(data, (size_t)length);
+    *has_free_key = false;
+    for (int i = 0; i < INTERN_MAX_COLLISIONS; i++, key++) {
+        uint32_t id;
+        if (!hashmap_get(&interner->map, key, &id)) {
+            *free_key = key;
+            *has_free_key = true;
+            return INTERN_INVALID;
+        }
+        if (interner_matches(interner, id, data, length)) {
+            return id;
+        }
+    }
+    return INTERN_INVALID;
+}
+
+uint32_t interner_intern(StringInterner* interner, const char* data, int length) {
+    if (length < 0 || interner->capacity == 0) {
+        return INTERN_INVALID;
+    }
+    uint64_t key = 0;
+    bool has_key = false;
+    uint32_t id = interner_lookup(interner, data, length, &key, &has_key);
+    if (id != INTERN_INVALID || !has_key || interner->count == interner->capacity) {
+        return id;
+    }
+
+    char* copy = arena_alloc(interner->arena, (size_t)length + 1, 1);
+    if (copy == NULL) {
+        return INTERN_INVALID;
+    }
+    memcpy(copy, data, (size_t)length);
+    copy[length] = '\0';
+
+    id = ++interner->count;
+    interner->strings[id] = copy;
+    interner->lengths[id] = length;
+    if (!hashmap_put(&interner->map, key, id)) {
+        interner->count--;
+        return INTERN_INVALID;
+    }
+    return id;
+}
+
+uint32_t interner_find(const StringInterner* interner, const char* data, int length) {
+    uint64_t key = 0;
+    bool has_key = false;
+    if (length < 0 || interner->capacity == 0) {
+        return INTERN_INVALID;
+    }
+    return interner_lookup(interner, data, length, &key, &has_key);
+}
+
+const char* interner_string(const StringInterner* interner, uint32_t id, int* length) {
+    if (id == INTERN_INVALID || id > interner->count) {
+        if (length) {
+            *length = 0;
+        }
+        return NULL;
+    }
+    if (length) {
+        *length = interner->lengths[id];
+    }
+    return interner->strings[id];
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+#include "arena.h"
+#include "hashmap.h"
+#include <stdint.h>
+
+// String interner: maps strings (asset names, pattern names, UI labels) to
+// stable 32-bit IDs. Strings are hashed and compared once, when interned;
+// after that code keys its own lookups by ID. IDs start at 1, 0 is invalid.
+// Interned strings are copied into the arena and NUL-terminated.
+
+#define INTERN_INVALID 0u
+
+typedef struct {
+    Arena* arena;
+    HashMap map;  // string hash -> ID
+    const char** strings;
+    int* lengths;
+    uint32_t count;
+    uint32_t capacity;
+} StringInterner;
+
+bool interner_init(StringInterner* interner, Arena* arena, uint32_t max_strings);
+
+// Returns the existing ID or adds the string; INTERN_INVALID when full
+uint32_t interner_intern(StringInterner* interner, const char* data, int length);
+
+// Returns the ID without adding, or INTERN_INVALID
+uint32_t interner_find(const StringInterner* interner, const char* data, int length);
+
+const char* interner_string(const StringInterner* interner, uint32_t id, int* length);
+
+#endif // INTERN_H
\ No newline at end of file
@@ -0,0 +1,282 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L  // pthreads under -std=c99
+#endif
+
+#include "loader.h"
+#include "mem.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+typedef enum {
+    REQUEST_FREE,
+    REQUEST_QUEUED,
+    REQUEST_READING,
+    REQUEST_DONE,
+    REQUEST_FAILED,
+} RequestState;
+
+typedef struct {
+    RequestState state;
+    bool cancelled;         // while reading: drop the result
+    unsigned int sequence;  // queued in this order
+    char path[LOADER_PATH_MAX];
+    unsigned char* data;  // malloc'd on the worker, mem is main-thread only
+    size_t size;
+} LoaderRequest;
+
+static struct {
+    LoaderRequest requests[LOADER_MAX_REQUESTS];
+    unsigned int next_sequence;
+    bool started;
+    bool threaded;
+    bool stopping;
+} loader;
+
+#ifdef _WIN32
+static SRWLOCK loader_mutex = SRWLOCK_INIT;
+static CONDITION_VARIABLE loader_cond = CONDITION_VARIABLE_INIT;
+static HANDLE loader_thread;
+#else
+static pthread_mutex_t loader_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t loader_cond = PTHREAD_COND_INITIALIZER;
+static pthread_t loader_thread;
+#endif
+
+static void loader_lock(void) {
+#ifdef _WIN32
+    AcquireSRWLockExclusive(&loader_mutex);
+#else
+    pthread_mutex_lock(&loader_mutex);
+#endif
+}
+
+static void loader_unlock(void) {
+#ifdef _WIN32
+    ReleaseSRWLockExclusive(&loader_mutex);
+#else
+    pthread_mutex_unlock(&loader_mutex);
+#endif
+}
+
+static void loader_wait(void) {
+#ifdef _WIN32
+    SleepConditionVariableSRW(&loader_cond, &loader_mutex, INFINITE, 0);
+#else
+    pthread_cond_wait(&loader_cond, &loader_mutex);
+#endif
+}
+
+static void loader_wake(void) {
+#ifdef _WIN32
+    WakeAllConditionVariable(&loader_cond);
+#else
+    pthread_cond_broadcast(&loader_cond);
+#endif
+}
+
+static bool loader_read_file(const char* path, unsigned char** data, size_t* size) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char* bytes = length >= 0 ? malloc(length > 0 ? (size_t)length : 1) : NULL;
+    bool ok = bytes != NULL && fread(bytes, 1, (size_t)length, file) == (size_t)length;
+    fclose(file);
+    if (!ok) {
+        free(bytes);
+        return false;
+    }
+    *data = bytes;
+    *size = (size_t)length;
+    return true;
+}
+
+// Oldest queued request, or NULL
+static LoaderRequest* loader_next_queued(void) {
+    LoaderRequest* next = NULL;
+    for (int i = 0; i < LOADER_MAX_REQUESTS; i++) {
+        LoaderRequest* request = &loader.requests[i];
+        if (request->state == REQUEST_QUEUED && (next == NULL || request->sequence - next->sequence > 0x80000000u)) {
+            next = request;
+        }
+    }
+    return next;
+}
+
+static void loader_run_request(LoaderRequest* request, const char* path) {
+    unsigned char* data = NULL;
+    size_t size = 0;
+    bool ok = loader_read_file(path, &data, &size);
+
+    loader_lock();
+    if (request->cancelled) {
+        free(data);
+        request->state = REQUEST_FREE;
+    } else {
+        request->state = ok ? REQUEST_DONE : REQUEST_FAILED;
+        request->data = data;
+        request->size = size;
+    }
+    loader_unlock();
+}
+
+static void loader_worker_loop(void) {
+    char path[LOADER_PATH_MAX];
+    loader_lock();
+    for (;;) {
+        LoaderRequest* request = loader_next_queued();
+        while (request == NULL && !loader.stopping) {
+            loader_wait();
+            request = loader_next_queued();
+        }
+        if (loader.stopping) {
+            break;
+        }
+        request->state = REQUEST_READING;
+        request->cancelled = false;
+        memcpy(path, request->path, sizeof(path));
+        loader_unlock();
+        loader_run_request(request, path);
+        loader_lock();
+    }
+    loader_unlock();
+}
+
+#ifdef _WIN32
+static DWORD WINAPI loader_worker_main(LPVOID arg) {
+    (void)arg;
+    loader_worker_loop();
+    return 0;
+}
+#else
+static void* loader_worker_main(void* arg) {
+    (void)arg;
+    loader_worker_loop();
+    return NULL;
+}
+#endif
+
+static void loader_start_worker(void) {
+    loader.started = true;
+    loader.stopping = false;
+#ifdef _WIN32
+    loader_thread = CreateThread(NULL, 0, loader_worker_main, NULL, 0, NULL);
+    loader.threaded = loader_thread != NULL;
+#else
+    // Fails without thread support (e.g. wasm built without -pthread)
+    loader.threaded = pthread_create(&loader_thread, NULL, loader_worker_main, NULL) == 0;
+#endif
+}
+
+int loader_read(const char* path) {
+    size_t length = strlen(path);
+    if (length >= LOADER_PATH_MAX) {
+        return -1;
+    }
+    if (!loader.started) {
+        loader_start_worker();
+    }
+
+    loader_lock();
+    int slot = 0;
+    while (slot < LOADER_MAX_REQUESTS && loader.requests[slot].state != REQUEST_FREE) {
+        slot++;
+    }
+    if (slot == LOADER_MAX_REQUESTS) {
+        loader_unlock();
+        return -1;
+    }
+    LoaderRequest* request = &loader.requests[slot];
+    memcpy(request->path, path, length + 1);
+    request->sequence = loader.next_sequence++;
+    request->cancelled = false;
+    request->data = NULL;
+    request->size = 0;
+    request->state = loader.threaded ? REQUEST_QUEUED : REQUEST_READING;
+    loader_wake();
+    loader_unlock();
+
+    if (!loader.threaded) {
+        loader_run_request(request, request->path);
+    }
+    return slot;
+}
+
+LoaderStatus loader_poll(int request, unsigned char** data, size_t* size) {
+    if (request < 0 || request >= LOADER_MAX_REQUESTS) {
+        return LOADER_FAILED;
+    }
+    LoaderRequest* entry = &loader.requests[request];
+    loader_lock();
+    RequestState state = entry->state;
+    if (state == REQUEST_DONE) {
+        *data = entry->data;
+        *size = entry->size;
+        entry->data = NULL;
+    }
+    if (state == REQUEST_DONE || state == REQUEST_FAILED || state == REQUEST_FREE) {
+        entry->state = REQUEST_FREE;
+    }
+    loader_unlock();
+
+    if (state == REQUEST_DONE) {
+        mem_track(MEM_TAG_ASSETS, *size);
+        return LOADER_DONE;
+    }
+    return state == REQUEST_QUEUED || state == REQUEST_READING ? LOADER_PENDING : LOADER_FAILED;
+}
+
+void loader_cancel(int request) {
+    if (request < 0 || request >= LOADER_MAX_REQUESTS) {
+        return;
+    }
+    LoaderRequest* entry = &loader.requests[request];
+    loader_lock();
+    if (entry->state == REQUEST_READING) {
+        entry->cancelled = true;
+    } else {
+        free(entry->data);
+        entry->data = NULL;
+        entry->state = REQUEST_FREE;
+    }
+    loader_unlock();
+}
+
+void loader_free(unsigned char* data, size_t size) {
+    if (data != NULL) {
+        mem_untrack(MEM_TAG_ASSETS, size);
+        free(data);
+    }
+}
+
+void loader_shutdown(void) {
+    if (!loader.started) {
+        return;
+    }
+    loader_lock();
+    loader.stopping = true;
+    loader_wake();
+    loader_unlock();
+    if (loader.threaded) {
+#ifdef _WIN32
+        WaitForSingleObject(loader_thread, INFINITE);
+        CloseHandle(loader_thread);
+#else
+        pthread_join(loader_thread, NULL);
+#endif
+    }
+    for (int i = 0; i < LOADER_MAX_REQUESTS; i++) {
+        free(loader.requests[i].data);
+    }
+    memset(&loader, 0, sizeof(loader));
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#ifndef LOADER_H
+#define LOADER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Whole-file reads on a background thread, so the main thread never waits
+// on the disk mid-game: request a read, poll it once per frame, decode or
+// upload the bytes when they arrive. Where threads aren't available (wasm
+// without pthreads) loader_read reads inline and the request is complete
+// on return.
+//
+// Call everything from the main thread. Finished buffers are counted
+// against MEM_TAG_ASSETS once handed over and must go back through
+// loader_free.
+
+#define LOADER_MAX_REQUESTS 16
+#define LOADER_PATH_MAX 256
+
+typedef enum {
+    LOADER_PENDING,
+    LOADER_DONE,    // data and size are filled in, the request is released
+    LOADER_FAILED,  // file missing or unreadable, the request is released
+} LoaderStatus;
+
+// Returns a request handle, or -1 if all requests are in flight or the
+// path is too long
+int loader_read(const char* path);
+LoaderStatus loader_poll(int request, unsigned char** data, size_t* size);
+// Drops a request; a read already running is discarded when it finishes
+void loader_cancel(int request);
+void loader_free(unsigned char* data, size_t size);
+
+// Cancels outstanding requests and stops the thread
+void loader_shutdown(void);
+
+#endif // LOADER_H
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include "mem.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Each block is prefixed with its size and tag. 16 bytes keeps the user
+// pointer as aligned as malloc's.
+typedef struct {
+    size_t size;
+    size_t tag;
+} MemHeader;
+
+#define MEM_HEADER_SIZE 16
+
+typedef struct {
+    MemTagStats stats;
+    unsigned int frame_allocs;  // current frame
+} MemTagState;
+
+static MemTagState tags[MEM_TAG_COUNT];
+static size_t total_live = 0;
+static size_t total_peak = 0;
+
+static const char* tag_names[MEM_TAG_COUNT] = {"graphics", "audio", "assets", "gameplay", "ui"};
+
+static MemHeader* header_of(void* ptr) {
+    return (MemHeader*)((unsigned char*)ptr - MEM_HEADER_SIZE);
+}
+
+static void track_alloc(MemTag tag, size_t size) {
+    MemTagState* state = &tags[tag];
+    state->stats.live_bytes += size;
+    if (state->stats.live_bytes > state->stats.peak_bytes) {
+        state->stats.peak_bytes = state->stats.live_bytes;
+    }
+    state->stats.total_allocs++;
+    state->frame_allocs++;
+    total_live += size;
+    if (total_live > total_peak) {
+        total_peak = total_live;
+    }
+}
+
+static void track_free(MemTag tag, size_t size) {
+    tags[tag].stats.live_bytes -= size;
+    total_live -= size;
+}
+
+void* mem_alloc(MemTag tag, size_t size) {
+    if (tag >= MEM_TAG_COUNT || size > (size_t)-1 - MEM_HEADER_SIZE) {
+        return NULL;
+    }
+    unsigned char* block = malloc(MEM_HEADER_SIZE + size);
+    if (block == NULL) {
+        return NULL;
+    }
+    MemHeader* header = (MemHeader*)block;
+    header->size = size;
+    header->tag = (size_t)tag;
+    track_alloc(tag, size);
+    return block + MEM_HEADER_SIZE;
+}
+
+void* mem_calloc(MemTag tag, size_t count, size_t size) {
+    if (size != 0 && count > (size_t)-1 / size) {
+        return NULL;
+    }
+    void* ptr = mem_alloc(tag, count * size);
+    if (ptr) {
+        memset(ptr, 0, count * size);
+    }
+    return ptr;
+}
+
+void* mem_realloc(MemTag tag, void* ptr, size_t size) {
+    if (ptr == NULL) {
+        return mem_alloc(tag, size);
+    }
+    if (size > (size_t)-1 - MEM_HEADER_SIZE) {
+        return NULL;
+    }
+    MemHeader* header = header_of(ptr);
+    MemTag owner = (MemTag)header->tag;
+    size_t old_size = header->size;
+
+    unsigned char* block = realloc(header, MEM_HEADER_SIZE + size);
+    if (block == NULL) {
+        return NULL;
+    }
+    header = (MemHeader*)block;
+    header->size = size;
+    track_free(owner, old_size);
+    track_alloc(owner, size);
+    return block + MEM_HEADER_SIZE;
+}
+
+void mem_free(void* ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    MemHeader* header = header_of(ptr);
+    track_free((MemTag)header->tag, header->size);
+    free(header);
+}
+
+void mem_track(MemTag tag, size_t size) {
+    if (tag < MEM_TAG_COUNT) {
+        track_alloc(tag, size);
+    }
+}
+
+void mem_untrack(MemTag tag, size_t size) {
+    if (tag < MEM_TAG_COUNT) {
+        track_free(tag, size);
+    }
+}
+
+void mem_end_frame(void) {
+    for (int i = 0; i < MEM_TAG_COUNT; i++) {
+        tags[i].stats.frame_allocs = tags[i].frame_allocs;
+        tags[i].frame_allocs = 0;
+    }
+}
+
+MemTagStats mem_get_stats(MemTag tag) {
+    MemTagStats empty = {0, 0, 0, 0};
+    return tag < MEM_TAG_COUNT ? tags[tag].stats : empty;
+}
+
+MemTagStats mem_get_total(void) {
+    MemTagStats total = {total_live, total_peak, 0, 0};
+    for (int i = 0; i < MEM_TAG_COUNT; i++) {
+        total.frame_allocs += tags[i].stats.frame_allocs;
+        total.total_allocs += tags[i].stats.total_allocs;
+    }
+    return total;
+}
+
+const char* mem_tag_name(MemTag tag) {
+    return tag < MEM_TAG_COUNT ? tag_names[tag] : "unknown";
+}
\ No newline at end of file
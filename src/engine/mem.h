@@ -0,0 +1,46 @@
+#ifndef MEM_H
+#define MEM_H
+
+#include <stddef.h>
+
+// Tagged heap allocation. Every engine allocation goes through here with the
+// subsystem it belongs to, so the perf HUD and bench output can show what
+// fills memory (on wasm, the linear memory) and catch code that allocates
+// every frame. Arenas are one tagged allocation each.
+//
+// Not thread-safe: allocate from the main thread.
+
+typedef enum {
+    MEM_TAG_GRAPHICS,
+    MEM_TAG_AUDIO,
+    MEM_TAG_ASSETS,
+    MEM_TAG_GAMEPLAY,
+    MEM_TAG_UI,
+    MEM_TAG_COUNT
+} MemTag;
+
+typedef struct {
+    size_t live_bytes;
+    size_t peak_bytes;
+    unsigned int frame_allocs;  // during the last completed frame
+    unsigned int total_allocs;
+} MemTagStats;
+
+void* mem_alloc(MemTag tag, size_t size);
+void* mem_calloc(MemTag tag, size_t count, size_t size);
+// Keeps the tag the block was allocated with; tag is used when ptr is NULL
+void* mem_realloc(MemTag tag, void* ptr, size_t size);
+void mem_free(void* ptr);
+
+// Counts memory obtained outside mem_alloc (mmap'd arenas) against a tag
+void mem_track(MemTag tag, size_t size);
+void mem_untrack(MemTag tag, size_t size);
+
+// Closes the per-frame allocation counts, call once per frame
+void mem_end_frame(void);
+
+MemTagStats mem_get_stats(MemTag tag);
+MemTagStats mem_get_total(void);
+const char* mem_tag_name(MemTag tag);
+
+#endif // MEM_H
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "origin.h"
+#include "camera.h"
+#include "tilemap.h"
+#include <math.h>
+#include <stddef.h>
+
+typedef struct {
+    float* values;
+    const int* count;
+} OriginArray;
+
+typedef struct {
+    float threshold;
+    float quantum;
+    double offset;
+    OriginArray arrays[ORIGIN_MAX_ARRAYS];
+    int array_count;
+} Origin;
+
+static Origin origin = {.threshold = 4096.0f, .quantum = 512.0f};
+
+void origin_init(float threshold, float quantum) {
+    origin.threshold = threshold > 0.0f ? threshold : 4096.0f;
+    origin.quantum = quantum > 0.0f ? quantum : 1.0f;
+    origin.offset = 0.0;
+}
+
+bool origin_register_array(float* values, const int* count) {
+    if (origin.array_count == ORIGIN_MAX_ARRAYS || values == NULL || count == NULL) {
+        return false;
+    }
+    origin.arrays[origin.array_count++] = (OriginArray){values, count};
+    return true;
+}
+
+void origin_unregister_array(float* values) {
+    for (int i = 0; i < origin.array_count; i++) {
+        if (origin.arrays[i].values == values) {
+            origin.arrays[i] = origin.arrays[--origin.array_count];
+            return;
+        }
+    }
+}
+
+static void origin_shift_array(float* values, int count, float dx) {
+    // Plain contiguous loop so the compiler vectorizes it
+    for (int i = 0; i < count; i++) {
+        values[i] -= dx;
+    }
+}
+
+bool origin_update(float focus_x) {
+    if (fabsf(focus_x) < origin.threshold) {
+        return false;
+    }
+
+    // Whole quanta only; focus ends up within one quantum of zero
+    float dx = floorf(focus_x / origin.quantum) * origin.quantum;
+    if (dx == 0.0f) {
+        return false;
+    }
+
+    for (int i = 0; i < origin.array_count; i++) {
+        OriginArray* array = &origin.arrays[i];
+        origin_shift_array(array->values, *array->count, dx);
+    }
+    camera_rebase(dx, 0.0f);
+    tilemap_rebase(dx);
+
+    origin.offset += (double)dx;
+    return true;
+}
+
+double origin_offset(void) {
+    return origin.offset;
+}
+
+double origin_absolute_x(float local_x) {
+    return origin.offset + (double)local_x;
+}
\ No newline at end of file
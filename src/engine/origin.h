@@ -0,0 +1,36 @@
+#ifndef ORIGIN_H
+#define ORIGIN_H
+
+#include <stdbool.h>
+
+// Floating origin for arbitrarily long runs. World x keeps growing in an
+// infinite runner, and float positions lose precision the further they get
+// from zero. Once the focus (usually the player) passes the threshold, every
+// world-space x is shifted back by a whole number of quanta, so simulation
+// always runs on small, precise local coordinates.
+//
+// The camera and tilemap are shifted automatically. Game code registers its
+// own position arrays (SoA, contiguous floats) and they are shifted in one
+// pass each. The total shift is kept in double precision for distance/score.
+
+#define ORIGIN_MAX_ARRAYS 32
+
+// threshold: how far from zero the focus may get before rebasing
+// quantum: shifts are multiples of this (e.g. a tilemap chunk width), which
+//          keeps grid-aligned things grid-aligned
+void origin_init(float threshold, float quantum);
+
+// values[0..*count) are world x positions; count is read at rebase time so
+// arrays can grow and shrink after registering
+bool origin_register_array(float* values, const int* count);
+void origin_unregister_array(float* values);
+
+// Rebases if needed; returns true if everything was shifted this call
+bool origin_update(float focus_x);
+
+// Total distance the origin has moved, and local x converted back to an
+// absolute world position
+double origin_offset(void);
+double origin_absolute_x(float local_x);
+
+#endif // ORIGIN_H
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "perf.h"
+#include "graphics.h"
+#include "mem.h"
+#include <stdio.h>
+
+#define PERF_HUD_WIDTH 240
+#define PERF_HUD_LINE 14
+#define PERF_HUD_GRAPH_HEIGHT 40
+#define PERF_GRAPH_MS 33.3f  // frame time at the top of the graph
+
+static struct {
+    bool hud_visible;
+    double frame_start;
+    float frame_ms;
+    float cpu_ms;
+    float history[PERF_HISTORY];
+    int history_next;
+    int history_count;
+#ifdef DEBUG_DRAW_ENABLED
+} perf = {.hud_visible = true};
+#else
+} perf = {.hud_visible = false};  // developer overlay, F3 shows it
+#endif
+
+void perf_begin_frame(void) {
+    double now = graphics_get_time();
+    if (perf.frame_start > 0.0) {
+        perf.frame_ms = (float)((now - perf.frame_start) * 1000.0);
+        perf.history[perf.history_next] = perf.frame_ms;
+        perf.history_next = (perf.history_next + 1) % PERF_HISTORY;
+        if (perf.history_count < PERF_HISTORY) {
+            perf.history_count++;
+        }
+    }
+    perf.frame_start = now;
+}
+
+void perf_end_frame(void) {
+    perf.cpu_ms = (float)((graphics_get_time() - perf.frame_start) * 1000.0);
+    mem_end_frame();
+}
+
+PerfStats perf_get_stats(void) {
+    PerfStats stats = {perf.frame_ms, 0.0f, 0.0f, perf.cpu_ms};
+    float total = 0.0f;
+    for (int i = 0; i < perf.history_count; i++) {
+        total += perf.history[i];
+        if (perf.history[i] > stats.frame_ms_max) {
+            stats.frame_ms_max = perf.history[i];
+        }
+    }
+    if (perf.history_count > 0) {
+        stats.frame_ms_avg = total / (float)perf.history_count;
+    }
+    return stats;
+}
+
+void perf_set_hud_visible(bool visible) {
+    perf.hud_visible = visible;
+}
+
+bool perf_is_hud_visible(void) {
+    return perf.hud_visible;
+}
+
+void perf_toggle_hud(void) {
+    perf.hud_visible = !perf.hud_visible;
+}
+
+static void hud_line(int x, int* y, const char* text, int length) {
+    if (length <= 0) {
+        return;
+    }
+    if (length >= 96) {
+        length = 95;
+    }
+    graphics_draw_text_view(graphics_string_view_n(text, length), x, *y, 10, COLOR_WHITE);
+    *y += PERF_HUD_LINE;
+}
+
+void perf_draw_hud(int x, int y) {
+    if (!perf.hud_visible) {
+        return;
+    }
+    PerfStats stats = perf_get_stats();
+    GfxFrameStats frame = graphics_get_frame_stats();
+    GfxTextureStats tex = graphics_get_texture_stats();
+
+    int lines = 5;
+    for (int i = 0; i < MEM_TAG_COUNT; i++) {
+        lines += mem_get_stats((MemTag)i).peak_bytes > 0;
+    }
+    int height = lines * PERF_HUD_LINE + PERF_HUD_GRAPH_HEIGHT + 12;
+    graphics_draw_rectangle((GfxRectangle){(float)x, (float)y, PERF_HUD_WIDTH, (float)height},
+                            (GfxColor){0, 0, 0, 170});
+
+    char text[96];
+    int line_y = y + 4;
+    int tx = x + 4;
+    hud_line(tx, &line_y, text,
+             snprintf(text, sizeof(text), "frame %.2f ms  avg %.2f  max %.2f", stats.frame_ms, stats.frame_ms_avg,
+                      stats.frame_ms_max));
+    hud_line(tx, &line_y, text,
+             snprintf(text, sizeof(text), "cpu %.2f ms  draws %d  verts %d  culled %d", stats.cpu_ms,
+                      frame.draw_calls, frame.vertices, frame.culled));
+    if (tex.budget_bytes > 0) {
+        hud_line(tx, &line_y, text,
+                 snprintf(text, sizeof(text), "tex %d  %.1f / %.1f MB", tex.resident_count,
+                          (double)tex.resident_bytes / (1024.0 * 1024.0),
+                          (double)tex.budget_bytes / (1024.0 * 1024.0)));
+    } else {
+        hud_line(tx, &line_y, text,
+                 snprintf(text, sizeof(text), "tex %d  %.1f MB", tex.resident_count,
+                          (double)tex.resident_bytes / (1024.0 * 1024.0)));
+    }
+    hud_line(tx, &line_y, text,
+             snprintf(text, sizeof(text), "evicted %u  reloaded %u  pending %d", tex.evictions, tex.reloads,
+                      tex.pending_reloads));
+
+    MemTagStats total = mem_get_total();
+    hud_line(tx, &line_y, text,
+             snprintf(text, sizeof(text), "heap %.2f MB  peak %.2f  allocs/frame %u",
+                      (double)total.live_bytes / (1024.0 * 1024.0), (double)total.peak_bytes / (1024.0 * 1024.0),
+                      total.frame_allocs));
+    for (int i = 0; i < MEM_TAG_COUNT; i++) {
+        MemTagStats tag = mem_get_stats((MemTag)i);
+        if (tag.peak_bytes == 0) {
+            continue;
+        }
+        hud_line(tx + 8, &line_y, text,
+                 snprintf(text, sizeof(text), "%-8s %8.1f KB  peak %.1f  allocs %u", mem_tag_name((MemTag)i),
+                          (double)tag.live_bytes / 1024.0, (double)tag.peak_bytes / 1024.0, tag.frame_allocs));
+    }
+
+    // Frame time graph, oldest on the left; bars past the 60 Hz budget turn red
+    float bar_w = (float)(PERF_HUD_WIDTH - 8) / (float)PERF_HISTORY;
+    float base_y = (float)(line_y + 4 + PERF_HUD_GRAPH_HEIGHT);
+    for (int i = 0; i < perf.history_count; i++) {
+        int index = (perf.history_next - perf.history_count + i + PERF_HISTORY) % PERF_HISTORY;
+        float ms = perf.history[index];
+        float h = ms / PERF_GRAPH_MS * (float)PERF_HUD_GRAPH_HEIGHT;
+        if (h > (float)PERF_HUD_GRAPH_HEIGHT) {
+            h = (float)PERF_HUD_GRAPH_HEIGHT;
+        }
+        GfxColor color = ms > 16.7f ? (GfxColor){230, 60, 60, 255} : (GfxColor){80, 200, 120, 255};
+        graphics_draw_rectangle((GfxRectangle){(float)tx + (float)i * bar_w, base_y - h, bar_w, h}, color);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef PERF_H
+#define PERF_H
+
+#include <stdbool.h>
+
+// Frame timing and the perf HUD: frame time (average and worst over the
+// last PERF_HISTORY frames), draw calls, texture residency and tagged heap
+// memory.
+//
+// Call perf_begin_frame before graphics_begin_frame and perf_end_frame after
+// graphics_end_frame, so the measured frame includes presenting it.
+// perf_end_frame also closes the per-frame allocation counts in mem.
+
+#define PERF_HISTORY 120
+
+typedef struct {
+    float frame_ms;  // last frame, begin to begin
+    float frame_ms_avg;
+    float frame_ms_max;
+    float cpu_ms;  // last frame, begin to end, excluding the wait for the next one
+} PerfStats;
+
+void perf_begin_frame(void);
+void perf_end_frame(void);
+PerfStats perf_get_stats(void);
+
+void perf_set_hud_visible(bool visible);
+bool perf_is_hud_visible(void);
+void perf_toggle_hud(void);
+
+// Draws the HUD with its top-left corner at (x, y), in screen space
+void perf_draw_hud(int x, int y);
+
+#endif // PERF_H
\ No newline at end of file
@@ -0,0 +1,362 @@
+#include "simd.h"
+#include <stdint.h>
+#include <string.h>
+
+// The intrinsic paths never fuse a multiply and add, so the scalar code
+// (loop tails and --simd scalar) mustn't either. clang contracts by
+// default and would emit FMAs on targets that have them (x86-64-v3,
+// aarch64); gcc keeps them apart under -std=c99. Reset at the end of the
+// file so the unity build's other sources are unaffected.
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SIMD_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#define SIMD_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+#if defined(__ARM_NEON)
+#define SIMD_ARM 1
+#include <arm_neon.h>
+#endif
+
+// The vector kernels treat vertices as a flat float array, five per vertex
+typedef char simd_vertex_layout_check[sizeof(GfxVertex) == 5 * sizeof(float) ? 1 : -1];
+
+#define VERTEX_FLOATS 5
+
+typedef void (*TransformKernel)(GfxVertex* vertices, int count, float scale, float bias_x, float bias_y);
+typedef void (*AdvanceKernel)(float* time, const float* speed, const float* wrap, const float* frame_start,
+                              const float* frame_end, unsigned char* dirty, float dt, int count);
+
+typedef struct {
+    TransformKernel transform;
+    AdvanceKernel advance;
+} SimdKernels;
+
+static const char* level_names[SIMD_LEVEL_COUNT] = {"scalar", "sse2", "avx2", "avx512", "neon"};
+
+// Scalar versions, also used for the tails of the vector loops
+
+static void transform_scalar(GfxVertex* vertices, int count, float scale, float bias_x, float bias_y) {
+    for (int i = 0; i < count; i++) {
+        vertices[i].x = vertices[i].x * scale + bias_x;
+        vertices[i].y = vertices[i].y * scale + bias_y;
+    }
+}
+
+static void advance_scalar(float* time, const float* speed, const float* wrap, const float* frame_start,
+                           const float* frame_end, unsigned char* dirty, float dt, int count) {
+    for (int i = 0; i < count; i++) {
+        float t = time[i] + dt * speed[i];
+        t -= (t >= wrap[i]) ? wrap[i] : 0.0f;
+        time[i] = t;
+        dirty[i] = (unsigned char)((t >= frame_end[i]) | (t < frame_start[i]));
+    }
+}
+
+static void store_dirty(unsigned char* dirty, unsigned int bits, int lanes) {
+    for (int k = 0; k < lanes; k++) {
+        dirty[k] = (unsigned char)((bits >> k) & 1u);
+    }
+}
+
+#ifdef SIMD_X86
+
+// SSE2: x,y of two vertices per register, moved with 64-bit loads and
+// stores so the other fields are never touched
+
+SIMD_TARGET("sse2")
+static void transform_sse2(GfxVertex* vertices, int count, float scale, float bias_x, float bias_y) {
+    __m128 vs = _mm_set1_ps(scale);
+    __m128 vb = _mm_setr_ps(bias_x, bias_y, bias_x, bias_y);
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m64* a = (__m64*)&vertices[i].x;
+        __m64* b = (__m64*)&vertices[i + 1].x;
+        __m128 v = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), a), b);
+        v = _mm_add_ps(_mm_mul_ps(v, vs), vb);
+        _mm_storel_pi(a, v);
+        _mm_storeh_pi(b, v);
+    }
+    transform_scalar(vertices + i, count - i, scale, bias_x, bias_y);
+}
+
+SIMD_TARGET("sse2")
+static void advance_sse2(float* time, const float* speed, const float* wrap, const float* frame_start,
+                         const float* frame_end, unsigned char* dirty, float dt, int count) {
+    __m128 vdt = _mm_set1_ps(dt);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 t = _mm_add_ps(_mm_loadu_ps(time + i), _mm_mul_ps(vdt, _mm_loadu_ps(speed + i)));
+        __m128 w = _mm_loadu_ps(wrap + i);
+        t = _mm_sub_ps(t, _mm_and_ps(_mm_cmpge_ps(t, w), w));
+        _mm_storeu_ps(time + i, t);
+        __m128 out = _mm_or_ps(_mm_cmpge_ps(t, _mm_loadu_ps(frame_end + i)),
+                               _mm_cmplt_ps(t, _mm_loadu_ps(frame_start + i)));
+        store_dirty(dirty + i, (unsigned int)_mm_movemask_ps(out), 4);
+    }
+    advance_scalar(time + i, speed + i, wrap + i, frame_start + i, frame_end + i, dirty + i, dt, count - i);
+}
+
+// AVX2: transform reuses the SSE2 kernel. Four vertices per 256-bit
+// register measured slower, the lane inserts and extracts cost more than
+// they save.
+
+SIMD_TARGET("avx2")
+static void advance_avx2(float* time, const float* speed, const float* wrap, const float* frame_start,
+                         const float* frame_end, unsigned char* dirty, float dt, int count) {
+    __m256 vdt = _mm256_set1_ps(dt);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 t = _mm256_add_ps(_mm256_loadu_ps(time + i), _mm256_mul_ps(vdt, _mm256_loadu_ps(speed + i)));
+        __m256 w = _mm256_loadu_ps(wrap + i);
+        t = _mm256_sub_ps(t, _mm256_and_ps(_mm256_cmp_ps(t, w, _CMP_GE_OQ), w));
+        _mm256_storeu_ps(time + i, t);
+        __m256 out = _mm256_or_ps(_mm256_cmp_ps(t, _mm256_loadu_ps(frame_end + i), _CMP_GE_OQ),
+                                  _mm256_cmp_ps(t, _mm256_loadu_ps(frame_start + i), _CMP_LT_OQ));
+        store_dirty(dirty + i, (unsigned int)_mm256_movemask_ps(out), 8);
+    }
+    advance_scalar(time + i, speed + i, wrap + i, frame_start + i, frame_end + i, dirty + i, dt, count - i);
+}
+
+// Per-lane constants for transforming `floats` consecutive floats (a whole
+// number of vertices) in place: x and y lanes get the bias, and the mask
+// keeps the other lanes (uv, packed color) bit for bit. Those lanes are
+// also zeroed before the arithmetic so color bytes never reach the FPU as
+// denormals, which take slow microcode assists.
+static void transform_pattern(float* bias, uint32_t* mask, int floats, float bias_x, float bias_y) {
+    for (int i = 0; i < floats; i++) {
+        int field = i % VERTEX_FLOATS;
+        bias[i] = field == 0 ? bias_x : (field == 1 ? bias_y : 0.0f);
+        mask[i] = field < 2 ? 0xFFFFFFFFu : 0u;
+    }
+}
+
+// AVX-512: 16 vertices (80 floats, 5 registers) per step, masks in k registers
+
+SIMD_TARGET("avx512f")
+static void transform_avx512(GfxVertex* vertices, int count, float scale, float bias_x, float bias_y) {
+    float b[80];
+    uint32_t m[80];
+    transform_pattern(b, m, 80, bias_x, bias_y);
+    __m512 vs = _mm512_set1_ps(scale);
+    __m512 vb[5];
+    __mmask16 vm[5];
+    for (int r = 0; r < 5; r++) {
+        vb[r] = _mm512_loadu_ps(&b[r * 16]);
+        unsigned int bits = 0;
+        for (int k = 0; k < 16; k++) {
+            bits |= (m[r * 16 + k] & 1u) << k;
+        }
+        vm[r] = (__mmask16)bits;
+    }
+
+    float* f = (float*)vertices;
+    int i = 0;
+    for (; i + 16 <= count; i += 16, f += 80) {
+        for (int r = 0; r < 5; r++) {
+            __m512 v = _mm512_loadu_ps(f + r * 16);
+            __m512 t = _mm512_add_ps(_mm512_maskz_mul_ps(vm[r], v, vs), vb[r]);
+            _mm512_storeu_ps(f + r * 16, _mm512_mask_blend_ps(vm[r], v, t));
+        }
+    }
+    transform_scalar(vertices + i, count - i, scale, bias_x, bias_y);
+}
+
+SIMD_TARGET("avx512f")
+static void advance_avx512(float* time, const float* speed, const float* wrap, const float* frame_start,
+                           const float* frame_end, unsigned char* dirty, float dt, int count) {
+    __m512 vdt = _mm512_set1_ps(dt);
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512 t = _mm512_add_ps(_mm512_loadu_ps(time + i), _mm512_mul_ps(vdt, _mm512_loadu_ps(speed + i)));
+        __m512 w = _mm512_loadu_ps(wrap + i);
+        t = _mm512_mask_sub_ps(t, _mm512_cmp_ps_mask(t, w, _CMP_GE_OQ), t, w);
+        _mm512_storeu_ps(time + i, t);
+        __mmask16 out = (__mmask16)(_mm512_cmp_ps_mask(t, _mm512_loadu_ps(frame_end + i), _CMP_GE_OQ) |
+                                    _mm512_cmp_ps_mask(t, _mm512_loadu_ps(frame_start + i), _CMP_LT_OQ));
+        store_dirty(dirty + i, (unsigned int)out, 16);
+    }
+    advance_scalar(time + i, speed + i, wrap + i, frame_start + i, frame_end + i, dirty + i, dt, count - i);
+}
+
+static uint64_t read_xcr0(void) {
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((uint64_t)edx << 32) | eax;
+}
+
+// cpuid reports what the CPU has; xgetbv whether the OS saves the wider
+// registers on context switch, without which AVX can't be used
+static SimdLevel detect_x86(void) {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return SIMD_SCALAR;
+    }
+    SimdLevel level = (edx & (1u << 26)) ? SIMD_SSE2 : SIMD_SCALAR;
+    bool osxsave = (ecx & (1u << 27)) != 0;
+    bool avx = (ecx & (1u << 28)) != 0;
+    if (!osxsave || !avx || __get_cpuid_max(0, NULL) < 7) {
+        return level;
+    }
+
+    uint64_t xcr0 = read_xcr0();
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    if ((ebx & (1u << 5)) && (xcr0 & 0x6) == 0x6) {
+        level = SIMD_AVX2;
+    }
+    // Opmask and upper ZMM state on top of the AVX state
+    if ((ebx & (1u << 16)) && (xcr0 & 0xE6) == 0xE6) {
+        level = SIMD_AVX512;
+    }
+    return level;
+}
+
+#endif // SIMD_X86
+
+#ifdef SIMD_ARM
+
+// NEON: x,y of two vertices per register, as for SSE2
+
+static void transform_neon(GfxVertex* vertices, int count, float scale, float bias_x, float bias_y) {
+    float32x4_t vs = vdupq_n_f32(scale);
+    const float bias[4] = {bias_x, bias_y, bias_x, bias_y};
+    float32x4_t vb = vld1q_f32(bias);
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        float32x4_t v = vcombine_f32(vld1_f32(&vertices[i].x), vld1_f32(&vertices[i + 1].x));
+        v = vaddq_f32(vmulq_f32(v, vs), vb);
+        vst1_f32(&vertices[i].x, vget_low_f32(v));
+        vst1_f32(&vertices[i + 1].x, vget_high_f32(v));
+    }
+    transform_scalar(vertices + i, count - i, scale, bias_x, bias_y);
+}
+
+static void advance_neon(float* time, const float* speed, const float* wrap, const float* frame_start,
+                         const float* frame_end, unsigned char* dirty, float dt, int count) {
+    float32x4_t vdt = vdupq_n_f32(dt);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t t = vaddq_f32(vld1q_f32(time + i), vmulq_f32(vdt, vld1q_f32(speed + i)));
+        float32x4_t w = vld1q_f32(wrap + i);
+        uint32x4_t past = vcgeq_f32(t, w);
+        t = vsubq_f32(t, vreinterpretq_f32_u32(vandq_u32(past, vreinterpretq_u32_f32(w))));
+        vst1q_f32(time + i, t);
+        uint32x4_t out = vorrq_u32(vcgeq_f32(t, vld1q_f32(frame_end + i)), vcltq_f32(t, vld1q_f32(frame_start + i)));
+        uint32_t lanes[4];
+        vst1q_u32(lanes, out);
+        for (int k = 0; k < 4; k++) {
+            dirty[i + k] = (unsigned char)(lanes[k] & 1u);
+        }
+    }
+    advance_scalar(time + i, speed + i, wrap + i, frame_start + i, frame_end + i, dirty + i, dt, count - i);
+}
+
+#endif // SIMD_ARM
+
+static bool detected = false;
+static SimdLevel best_level = SIMD_SCALAR;
+static SimdLevel active_level = SIMD_SCALAR;
+static SimdKernels kernels = {transform_scalar, advance_scalar};
+
+static SimdKernels kernels_for(SimdLevel level) {
+    SimdKernels k = {transform_scalar, advance_scalar};
+    switch (level) {
+#ifdef SIMD_X86
+        case SIMD_SSE2:
+            k = (SimdKernels){transform_sse2, advance_sse2};
+            break;
+        case SIMD_AVX2:
+            k = (SimdKernels){transform_sse2, advance_avx2};
+            break;
+        case SIMD_AVX512:
+            k = (SimdKernels){transform_avx512, advance_avx512};
+            break;
+#endif
+#ifdef SIMD_ARM
+        case SIMD_NEON:
+            k = (SimdKernels){transform_neon, advance_neon};
+            break;
+#endif
+        default:
+            break;
+    }
+    return k;
+}
+
+static void simd_detect(void) {
+    if (detected) {
+        return;
+    }
+#if defined(SIMD_X86)
+    best_level = detect_x86();
+#elif defined(SIMD_ARM)
+    best_level = SIMD_NEON;
+#endif
+    active_level = best_level;
+    kernels = kernels_for(best_level);
+    detected = true;
+}
+
+SimdLevel simd_best_level(void) {
+    simd_detect();
+    return best_level;
+}
+
+SimdLevel simd_active_level(void) {
+    simd_detect();
+    return active_level;
+}
+
+// x86 levels include the ones below them; NEON stands alone
+bool simd_level_supported(SimdLevel level) {
+    simd_detect();
+    if (level == SIMD_SCALAR) {
+        return true;
+    }
+    if (level == SIMD_NEON || best_level == SIMD_NEON) {
+        return level == best_level;
+    }
+    return level < SIMD_LEVEL_COUNT && level <= best_level;
+}
+
+bool simd_force_level(SimdLevel level) {
+    if (!simd_level_supported(level)) {
+        return false;
+    }
+    active_level = level;
+    kernels = kernels_for(level);
+    return true;
+}
+
+const char* simd_level_name(SimdLevel level) {
+    return level < SIMD_LEVEL_COUNT ? level_names[level] : "unknown";
+}
+
+SimdLevel simd_level_from_name(const char* name) {
+    for (int i = 0; i < SIMD_LEVEL_COUNT; i++) {
+        if (strcmp(name, level_names[i]) == 0) {
+            return (SimdLevel)i;
+        }
+    }
+    return SIMD_LEVEL_COUNT;
+}
+
+void simd_transform_vertices(GfxVertex* vertices, int count, float scale, float bias_x, float bias_y) {
+    simd_detect();
+    kernels.transform(vertices, count, scale, bias_x, bias_y);
+}
+
+void simd_advance_animators(float* time, const float* speed, const float* wrap, const float* frame_start,
+                            const float* frame_end, unsigned char* dirty, float dt, int count) {
+    simd_detect();
+    kernels.advance(time, speed, wrap, frame_start, frame_end, dirty, dt, count);
+}
+
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT DEFAULT
+#endif
\ No newline at end of file
@@ -0,0 +1,42 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include "graphics.h"
+#include <stdbool.h>
+
+// Hot loops with one implementation per instruction set, picked at runtime
+// from what the CPU supports, so portable x86_64 builds still use AVX2 or
+// AVX-512 when they're there. All variants give identical results to the
+// scalar code (no FMA contraction), so forcing a level never changes the
+// simulation.
+
+typedef enum {
+    SIMD_SCALAR,
+    SIMD_SSE2,
+    SIMD_AVX2,
+    SIMD_AVX512,
+    SIMD_NEON,
+    SIMD_LEVEL_COUNT
+} SimdLevel;
+
+// Best level this CPU and build support; detection runs on first use
+SimdLevel simd_best_level(void);
+SimdLevel simd_active_level(void);
+bool simd_level_supported(SimdLevel level);
+
+// Pins a level (for benchmarks and testing); false if unsupported
+bool simd_force_level(SimdLevel level);
+
+const char* simd_level_name(SimdLevel level);
+SimdLevel simd_level_from_name(const char* name);  // SIMD_LEVEL_COUNT if unknown
+
+// x = x * scale + bias_x, y = y * scale + bias_y for each vertex, everything
+// else untouched (view transform)
+void simd_transform_vertices(GfxVertex* vertices, int count, float scale, float bias_x, float bias_y);
+
+// Animator clock step: time += dt * speed, minus wrap once it's reached;
+// dirty = the new time is outside [frame_start, frame_end)
+void simd_advance_animators(float* time, const float* speed, const float* wrap, const float* frame_start,
+                            const float* frame_end, unsigned char* dirty, float dt, int count);
+
+#endif // SIMD_H
\ No newline at end of file
@@ -0,0 +1,96 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200112L  // clock_gettime under -std=c99
+#endif
+
+#include "startup.h"
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+static struct {
+    double origin;
+    double first_frame_ms;
+    StartupStep steps[STARTUP_MAX_STEPS];
+    int step_count;
+} startup = {.first_frame_ms = -1.0};
+
+// Own clock: the backend's isn't usable before its window exists
+static double now_seconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+#endif
+}
+
+static double now_ms(void) {
+    return (now_seconds() - startup.origin) * 1000.0;
+}
+
+void startup_begin(void) {
+    startup.origin = now_seconds();
+    startup.first_frame_ms = -1.0;
+    startup.step_count = 0;
+}
+
+int startup_step_begin(const char* name) {
+    if (startup.step_count == STARTUP_MAX_STEPS) {
+        return -1;
+    }
+    int step = startup.step_count++;
+    startup.steps[step] = (StartupStep){name, now_ms(), -1.0};
+    return step;
+}
+
+void startup_step_end(int step) {
+    if (step < 0) {
+        return;
+    }
+    startup.steps[step].end_ms = now_ms();
+}
+
+void startup_first_frame(void) {
+    if (startup.first_frame_ms < 0.0) {
+        startup.first_frame_ms = now_ms();
+    }
+}
+
+double startup_first_frame_ms(void) {
+    return startup.first_frame_ms;
+}
+
+int startup_get_steps(StartupStep* steps, int max) {
+    int count = startup.step_count < max ? startup.step_count : max;
+    memcpy(steps, startup.steps, (size_t)count * sizeof(StartupStep));
+    return count;
+}
+
+void startup_print(FILE* out) {
+    StartupStep steps[STARTUP_MAX_STEPS];
+    int count = startup_get_steps(steps, STARTUP_MAX_STEPS);
+
+    if (startup.first_frame_ms >= 0.0) {
+        fprintf(out, "Startup: first frame at %.1f ms (budget %.0f ms)%s\n", startup.first_frame_ms,
+                STARTUP_BUDGET_MS, startup.first_frame_ms > STARTUP_BUDGET_MS ? ", OVER BUDGET" : "");
+    } else {
+        fprintf(out, "Startup: no frame presented yet\n");
+    }
+    for (int i = 0; i < count; i++) {
+        const StartupStep* step = &steps[i];
+        if (step->end_ms >= 0.0) {
+            fprintf(out, "  %8.1f .. %8.1f ms  %7.1f ms  %s\n", step->start_ms, step->end_ms,
+                    step->end_ms - step->start_ms, step->name);
+        } else {
+            fprintf(out, "  %8.1f .. (running)            %s\n", step->start_ms, step->name);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef STARTUP_H
+#define STARTUP_H
+
+#include <stdio.h>
+
+// Startup timeline. Each init step is traced with its start and end
+// relative to startup_begin, and the trace closes at the first presented
+// frame, so regressions in time to first frame show up step by step. The
+// target is a first frame within STARTUP_BUDGET_MS.
+//
+// Main thread only. Init the first frame doesn't need belongs off the
+// critical path instead of in a step: file reads go through loader.h and
+// are picked up on a later frame.
+
+#define STARTUP_BUDGET_MS 100.0
+#define STARTUP_MAX_STEPS 32
+
+typedef struct {
+    const char* name;
+    double start_ms;
+    double end_ms;  // -1 while running
+} StartupStep;
+
+// Call first thing in main; the timeline is relative to this
+void startup_begin(void);
+
+// Traced steps on the main thread; the name must outlive the trace
+int startup_step_begin(const char* name);  // -1 once the trace is full
+void startup_step_end(int step);
+
+// Call after the first frame is presented; closes the timeline
+void startup_first_frame(void);
+double startup_first_frame_ms(void);  // -1 before the first frame
+
+// Copies up to max steps in start order, returns how many were copied
+int startup_get_steps(StartupStep* steps, int max);
+void startup_print(FILE* out);
+
+#endif // STARTUP_H
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include "tilemap.h"
+#include <stdbool.h>
+#include <string.h>
+
+#define CHUNK_TILES (TILEMAP_CHUNK_WIDTH * TILEMAP_CHUNK_HEIGHT)
+
+typedef struct {
+    bool used;
+    float world_x;
+    int quad_count;
+    GfxVertex vertices[CHUNK_TILES * 4];  // chunk-local positions
+} TileChunk;
+
+typedef struct {
+    int texture_id;
+    int atlas_columns;
+    float cell_u, cell_v;
+    float tile_size;
+    float ground_y;
+    TileChunk chunks[TILEMAP_MAX_CHUNKS];
+    float end_x;
+} Tilemap;
+
+static Tilemap tilemap;
+
+// Every chunk shares one index list, and the scratch array its vertices are
+// moved into for drawing
+static int chunk_indices[CHUNK_TILES * 6];
+static GfxVertex draw_vertices[CHUNK_TILES * 4];
+
+void tilemap_init(int texture_id, int atlas_width, int atlas_height, int atlas_tile_size, float tile_size,
+                  float ground_y) {
+    memset(&tilemap, 0, sizeof(tilemap));
+    tilemap.texture_id = texture_id;
+    tilemap.atlas_columns = atlas_tile_size > 0 ? atlas_width / atlas_tile_size : 1;
+    if (tilemap.atlas_columns < 1) {
+        tilemap.atlas_columns = 1;
+    }
+    tilemap.cell_u = atlas_width > 0 ? (float)atlas_tile_size / (float)atlas_width : 1.0f;
+    tilemap.cell_v = atlas_height > 0 ? (float)atlas_tile_size / (float)atlas_height : 1.0f;
+    tilemap.tile_size = tile_size;
+    tilemap.ground_y = ground_y;
+
+    for (int q = 0; q < CHUNK_TILES; q++) {
+        int* idx = &chunk_indices[q * 6];
+        int base = q * 4;
+        idx[0] = base;
+        idx[1] = base + 1;
+        idx[2] = base + 2;
+        idx[3] = base;
+        idx[4] = base + 2;
+        idx[5] = base + 3;
+    }
+}
+
+static TileChunk* tilemap_claim_chunk(void) {
+    TileChunk* oldest = &tilemap.chunks[0];
+    for (int i = 0; i < TILEMAP_MAX_CHUNKS; i++) {
+        TileChunk* chunk = &tilemap.chunks[i];
+        if (!chunk->used) {
+            return chunk;
+        }
+        if (chunk->world_x < oldest->world_x) {
+            oldest = chunk;
+        }
+    }
+    return oldest;
+}
+
+void tilemap_bake_chunk(float world_x, const TileId* tiles) {
+    TileChunk* chunk = tilemap_claim_chunk();
+    float size = tilemap.tile_size;
+    GfxColor white = COLOR_WHITE;
+
+    chunk->used = true;
+    chunk->world_x = world_x;
+    chunk->quad_count = 0;
+
+    for (int row = 0; row < TILEMAP_CHUNK_HEIGHT; row++) {
+        for (int col = 0; col < TILEMAP_CHUNK_WIDTH; col++) {
+            TileId tile = tiles[row * TILEMAP_CHUNK_WIDTH + col];
+            if (tile == 0) {
+                continue;
+            }
+            int cell = tile - 1;
+            float u0 = (float)(cell % tilemap.atlas_columns) * tilemap.cell_u;
+            float v0 = (float)(cell / tilemap.atlas_columns) * tilemap.cell_v;
+            float u1 = u0 + tilemap.cell_u;
+            float v1 = v0 + tilemap.cell_v;
+            float x0 = (float)col * size;
+            float y0 = tilemap.ground_y + (float)row * size;
+
+            GfxVertex* v = &chunk->vertices[chunk->quad_count * 4];
+            v[0] = (GfxVertex){x0, y0, u0, v0, white};
+            v[1] = (GfxVertex){x0 + size, y0, u1, v0, white};
+            v[2] = (GfxVertex){x0 + size, y0 + size, u1, v1, white};
+            v[3] = (GfxVertex){x0, y0 + size, u0, v1, white};
+            chunk->quad_count++;
+        }
+    }
+
+    float chunk_end = world_x + (float)TILEMAP_CHUNK_WIDTH * size;
+    if (chunk_end > tilemap.end_x) {
+        tilemap.end_x = chunk_end;
+    }
+}
+
+float tilemap_end_x(void) {
+    return tilemap.end_x;
+}
+
+void tilemap_draw(float view_left, float view_right) {
+    float chunk_width = (float)TILEMAP_CHUNK_WIDTH * tilemap.tile_size;
+
+    for (int i = 0; i < TILEMAP_MAX_CHUNKS; i++) {
+        TileChunk* chunk = &tilemap.chunks[i];
+        if (!chunk->used || chunk->quad_count == 0) {
+            continue;
+        }
+        if (chunk->world_x + chunk_width <= view_left || chunk->world_x >= view_right) {
+            continue;
+        }
+
+        // The baked vertices never change; only the chunk's offset does
+        int vertex_count = chunk->quad_count * 4;
+        for (int v = 0; v < vertex_count; v++) {
+            draw_vertices[v] = chunk->vertices[v];
+            draw_vertices[v].x += chunk->world_x;
+        }
+        graphics_draw_geometry(tilemap.texture_id, draw_vertices, vertex_count, chunk_indices,
+                               chunk->quad_count * 6);
+    }
+}
+
+void tilemap_rebase(float dx) {
+    for (int i = 0; i < TILEMAP_MAX_CHUNKS; i++) {
+        tilemap.chunks[i].world_x -= dx;
+    }
+    tilemap.end_x -= dx;
+}
\ No newline at end of file
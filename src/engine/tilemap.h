@@ -0,0 +1,36 @@
+#ifndef TILEMAP_H
+#define TILEMAP_H
+
+#include "graphics.h"
+
+// Ground tilemap. Tiles are grouped in fixed-size chunks, and each chunk is
+// baked into a vertex array once, when it is generated. Drawing costs one
+// geometry call per visible chunk however many tiles it holds.
+
+#define TILEMAP_CHUNK_WIDTH 16
+#define TILEMAP_CHUNK_HEIGHT 4
+#define TILEMAP_MAX_CHUNKS 8
+
+// Tile 0 is empty; tile n uses cell n - 1 of the tileset, row-major
+typedef unsigned char TileId;
+
+void tilemap_init(int texture_id, int atlas_width, int atlas_height, int atlas_tile_size, float tile_size,
+                  float ground_y);
+
+// Bakes a chunk whose left edge is at world_x. tiles holds
+// TILEMAP_CHUNK_WIDTH * TILEMAP_CHUNK_HEIGHT ids, row-major from the top.
+// Reuses the chunk furthest to the left once all slots are taken.
+void tilemap_bake_chunk(float world_x, const TileId* tiles);
+
+// Right edge of the furthest chunk baked so far, for the generator
+float tilemap_end_x(void);
+
+// Draws the chunks overlapping [view_left, view_right) in world space, so
+// call it between camera_begin and camera_end
+void tilemap_draw(float view_left, float view_right);
+
+// Shifts every chunk left by dx after an origin rebase; baked vertices are
+// chunk-local so nothing is rebaked
+void tilemap_rebase(float dx);
+
+#endif // TILEMAP_H
\ No newline at end of file
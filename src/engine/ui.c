@@ -0,0 +1,259 @@
+#include "ui.h"
+
+#define UI_MAX_RECTS 128
+#define UI_MAX_TEXTS 128
+#define UI_LAYOUT_CACHE_SIZE 64
+
+typedef struct {
+    GfxRectangle rect;
+    GfxColor color;
+} UiRectCommand;
+
+typedef struct {
+    GfxStringView text;
+    int x, y, size;
+    GfxColor color;
+} UiTextCommand;
+
+// Size a widget or panel had last time it was laid out
+typedef struct {
+    unsigned int id;
+    float width, height;
+} UiLayoutEntry;
+
+typedef struct {
+    UiInput input;
+    UiStyle style;
+    bool style_set;
+
+    unsigned int hot_id;
+    unsigned int active_id;
+    bool mouse_was_down;
+    int focus_index;
+    int widget_index;
+    int widget_count;
+
+    // Current panel
+    unsigned int panel_id;
+    int panel_rect;
+    float panel_x, panel_y;
+    float panel_width;
+    float cursor_y;
+    float content_width;
+
+    UiRectCommand rects[UI_MAX_RECTS];
+    int rect_count;
+    UiTextCommand texts[UI_MAX_TEXTS];
+    int text_count;
+
+    UiLayoutEntry layout_cache[UI_LAYOUT_CACHE_SIZE];
+} UiState;
+
+static UiState ui;
+
+UiStyle ui_default_style(void) {
+    return (UiStyle){
+        .panel = (GfxColor){20, 20, 30, 220},
+        .button = (GfxColor){60, 70, 110, 255},
+        .button_hot = (GfxColor){90, 100, 150, 255},
+        .button_active = (GfxColor){40, 45, 80, 255},
+        .text = COLOR_WHITE,
+        .font_size = 20,
+        .padding = 12.0f,
+        .spacing = 8.0f,
+    };
+}
+
+void ui_set_style(UiStyle style) {
+    ui.style = style;
+    ui.style_set = true;
+}
+
+static unsigned int ui_widget_id(GfxStringView* label) {
+    if (label->hash == 0) {
+        label->hash = graphics_string_hash(label->data, label->length);
+    }
+    // Hashed with any "##" suffix, and mixed with the panel so the same
+    // label in two panels gets two IDs
+    unsigned int id = label->hash ^ (ui.panel_id * 0x9E3779B1u);
+    return id ? id : 1u;
+}
+
+// The part of a label that is drawn: everything before "##"
+static GfxStringView ui_visible_text(GfxStringView label) {
+    for (int i = 0; i + 1 < label.length; i++) {
+        if (label.data[i] == '#' && label.data[i + 1] == '#') {
+            return graphics_string_view_n(label.data, i);
+        }
+    }
+    return label;
+}
+
+static UiLayoutEntry* ui_layout(unsigned int id) {
+    UiLayoutEntry* entry = &ui.layout_cache[id % UI_LAYOUT_CACHE_SIZE];
+    if (entry->id != id) {
+        entry->id = id;
+        entry->width = 0.0f;
+        entry->height = 0.0f;
+    }
+    return entry;
+}
+
+// Text size is measured once per widget and then served from the layout cache
+static float ui_text_width(unsigned int id, GfxStringView* text) {
+    UiLayoutEntry* entry = ui_layout(id);
+    if (entry->height != (float)ui.style.font_size) {
+        entry->width = (float)graphics_measure_text_view(text, ui.style.font_size);
+        entry->height = (float)ui.style.font_size;
+    }
+    return entry->width;
+}
+
+static void ui_push_rect(GfxRectangle rect, GfxColor color) {
+    if (ui.rect_count < UI_MAX_RECTS) {
+        ui.rects[ui.rect_count++] = (UiRectCommand){rect, color};
+    }
+}
+
+static void ui_push_text(GfxStringView text, float x, float y, GfxColor color) {
+    if (ui.text_count < UI_MAX_TEXTS) {
+        ui.texts[ui.text_count++] = (UiTextCommand){text, (int)x, (int)y, ui.style.font_size, color};
+    }
+}
+
+static void ui_grow_content(float width, float height) {
+    if (width > ui.content_width) {
+        ui.content_width = width;
+    }
+    ui.cursor_y += height + ui.style.spacing;
+}
+
+void ui_begin(UiInput input) {
+    if (!ui.style_set) {
+        ui_set_style(ui_default_style());
+    }
+
+    ui.input = input;
+    ui.hot_id = 0;
+    ui.rect_count = 0;
+    ui.text_count = 0;
+
+    if (ui.widget_count > 0) {
+        ui.focus_index = (ui.focus_index + input.navigate + ui.widget_count) % ui.widget_count;
+    }
+    ui.widget_index = 0;
+}
+
+void ui_end(void) {
+    for (int i = 0; i < ui.rect_count; i++) {
+        graphics_draw_rectangle(ui.rects[i].rect, ui.rects[i].color);
+    }
+    for (int i = 0; i < ui.text_count; i++) {
+        UiTextCommand* cmd = &ui.texts[i];
+        graphics_draw_text_view(cmd->text, cmd->x, cmd->y, cmd->size, cmd->color);
+    }
+
+    if (!ui.input.mouse_down) {
+        ui.active_id = 0;
+    }
+    ui.mouse_was_down = ui.input.mouse_down;
+    ui.widget_count = ui.widget_index;
+}
+
+void ui_panel_begin(GfxStringView id, float center_x, float center_y) {
+    ui.panel_id = 0;
+    ui.panel_id = ui_widget_id(&id);
+
+    // Center using last frame's size; the first frame is laid out at the
+    // center point and settles on the next one
+    UiLayoutEntry* cached = ui_layout(ui.panel_id);
+    ui.panel_width = cached->width;
+    ui.panel_x = center_x - cached->width * 0.5f;
+    ui.panel_y = center_y - cached->height * 0.5f;
+    ui.cursor_y = ui.panel_y + ui.style.padding;
+    ui.content_width = 0.0f;
+
+    // Background is sized in ui_panel_end once the content is known
+    ui.panel_rect = ui.rect_count;
+    ui_push_rect((GfxRectangle){ui.panel_x, ui.panel_y, 0.0f, 0.0f}, ui.style.panel);
+}
+
+void ui_panel_end(void) {
+    float width = ui.content_width + ui.style.padding * 2.0f;
+    float height = ui.cursor_y - ui.style.spacing + ui.style.padding - ui.panel_y;
+
+    if (ui.panel_rect < ui.rect_count) {
+        ui.rects[ui.panel_rect].rect.width = width;
+        ui.rects[ui.panel_rect].rect.height = height;
+    }
+
+    UiLayoutEntry* cached = ui_layout(ui.panel_id);
+    cached->width = width;
+    cached->height = height;
+    ui.panel_id = 0;
+}
+
+void ui_label(GfxStringView label) {
+    unsigned int id = ui_widget_id(&label);
+    GfxStringView text = ui_visible_text(label);
+    float width = ui_text_width(id, &text);
+    float inner_width = ui.panel_width - ui.style.padding * 2.0f;
+    float x = ui.panel_x + ui.style.padding;
+
+    if (inner_width > width) {
+        x += (inner_width - width) * 0.5f;
+    }
+    ui_push_text(text, x, ui.cursor_y, ui.style.text);
+    ui_grow_content(width, (float)ui.style.font_size);
+}
+
+bool ui_button(GfxStringView label) {
+    unsigned int id = ui_widget_id(&label);
+    GfxStringView text = ui_visible_text(label);
+    float text_width = ui_text_width(id, &text);
+    float padding = ui.style.padding;
+
+    // Buttons stretch to the panel width from last frame so a column of
+    // buttons lines up
+    float width = text_width + padding * 2.0f;
+    float inner_width = ui.panel_width - padding * 2.0f;
+    if (inner_width > width) {
+        width = inner_width;
+    }
+    float height = (float)ui.style.font_size + padding;
+    GfxRectangle rect = {ui.panel_x + padding, ui.cursor_y, width, height};
+
+    UiInput* in = &ui.input;
+    bool hovered = in->mouse_x >= rect.x && in->mouse_x < rect.x + rect.width && in->mouse_y >= rect.y &&
+                   in->mouse_y < rect.y + rect.height;
+    bool focused = ui.widget_index == ui.focus_index;
+    bool clicked = false;
+
+    if (hovered) {
+        ui.hot_id = id;
+        ui.focus_index = ui.widget_index;
+        focused = true;
+        if (in->mouse_down && !ui.mouse_was_down) {
+            ui.active_id = id;
+        }
+        if (!in->mouse_down && ui.mouse_was_down && ui.active_id == id) {
+            clicked = true;
+        }
+    }
+    if (focused && in->activate) {
+        clicked = true;
+    }
+
+    GfxColor color = ui.style.button;
+    if (ui.active_id == id) {
+        color = ui.style.button_active;
+    } else if (hovered || focused) {
+        color = ui.style.button_hot;
+    }
+
+    ui_push_rect(rect, color);
+    ui_push_text(text, rect.x + (width - text_width) * 0.5f, rect.y + padding * 0.5f, ui.style.text);
+    ui_grow_content(width, height);
+    ui.widget_index++;
+    return clicked;
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef UI_H
+#define UI_H
+
+#include "graphics.h"
+#include <stdbool.h>
+
+// Immediate-mode UI for menus, pause and game over screens. Widgets are
+// declared every frame between ui_begin and ui_end; nothing is retained
+// except a small cache of per-widget layout keyed by hashed IDs, which is
+// what lets panels auto-size and center without a second layout pass.
+//
+// Draws are recorded and flushed in ui_end, backgrounds first and text
+// last, so a whole menu costs one run of rectangles and one run of text.
+// Text views passed in must stay valid until ui_end.
+
+typedef struct {
+    float mouse_x, mouse_y;
+    bool mouse_down;
+    bool activate;      // keyboard/gamepad confirm
+    int navigate;       // -1 previous widget, +1 next widget, 0 none
+} UiInput;
+
+typedef struct {
+    GfxColor panel;
+    GfxColor button;
+    GfxColor button_hot;
+    GfxColor button_active;
+    GfxColor text;
+    int font_size;
+    float padding;
+    float spacing;
+} UiStyle;
+
+UiStyle ui_default_style(void);
+void ui_set_style(UiStyle style);
+
+void ui_begin(UiInput input);
+void ui_end(void);
+
+// Panels stack their widgets vertically and are centered on (x, y) using the
+// size they had last frame
+void ui_panel_begin(GfxStringView id, float center_x, float center_y);
+void ui_panel_end(void);
+
+// Widgets are identified by their label within the panel. Text from "##"
+// on is part of the ID but not drawn, so two widgets showing the same text
+// stay apart: GFX_STRING("Pause##title") and GFX_STRING("Pause").
+void ui_label(GfxStringView label);
+bool ui_button(GfxStringView label);
+
+#endif // UI_H
\ No newline at end of file
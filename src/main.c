@@ -1,41 +1,291 @@
+#include "engine/audio.h"
+#include "engine/camera.h"
 #include "engine/graphics.h"
+#include "engine/input.h"
+#include "engine/loader.h"
+#include "engine/mem.h"
+#include "engine/perf.h"
+#include "engine/startup.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-int main(void) {
-    // Initialize graphics with the backend selected at compile time
-    #ifdef GRAPHICS_BACKEND_RAYLIB
-        graphics_init(800, 450, "Infinite Runner - Raylib Backend", GRAPHICS_RAYLIB);
-        printf("Running with Raylib backend\n");
-    #elif defined(GRAPHICS_BACKEND_SDL3)
-        graphics_init(800, 450, "Infinite Runner - SDL3 Backend", GRAPHICS_SDL3);
-        printf("Running with SDL3 backend\n");
-    #else
-        printf("No graphics backend defined!\n");
+// The backend is picked at build time (-Dgraphics); --backend only checks it
+#ifdef GRAPHICS_BACKEND_RAYLIB
+#define BACKEND GRAPHICS_RAYLIB
+#define BACKEND_NAME "raylib"
+#elif defined(GRAPHICS_BACKEND_SDL3)
+#define BACKEND GRAPHICS_SDL3
+#define BACKEND_NAME "sdl3"
+#elif defined(GRAPHICS_BACKEND_NULL)
+#define BACKEND GRAPHICS_NULL
+#define BACKEND_NAME "null"
+#else
+#define BACKEND_NAME "none"
+#endif
+
+typedef struct {
+    int width, height;
+    const char* backend;
+    long frames;  // 0 = until the window is closed
+    unsigned int seed;
+    const char* replay_path;
+    bool headless;
+    double tick_rate;  // simulation steps per second, 0 = follow the wall clock
+    const char* stats_path;
+    bool trace_startup;
+} Options;
+
+// Whole-run totals for --stats
+typedef struct {
+    long frames;
+    double wall_seconds;
+    double sim_seconds;
+    double frame_ms_total;
+    double frame_ms_max;
+    double cpu_ms_total;
+    long input_events;
+} RunStats;
+
+static void usage(FILE* out) {
+    fprintf(out,
+            "usage: infinite-runner [options]\n"
+            "  --resolution WxH   window size (default 800x450)\n"
+            "  --backend NAME     expected backend, fails if the build has another (raylib, sdl3, null)\n"
+            "  --frames N         quit after N frames\n"
+            "  --seed N           seed for everything randomized\n"
+            "  --replay PATH      play back input from a file (\"<seconds> <action> <down|up>\" lines)\n"
+            "  --headless         hidden, uncapped window; needs --frames\n"
+            "  --tick-rate HZ     fixed simulation step of 1/HZ seconds per frame\n"
+            "  --stats PATH       write run stats as JSON when done\n"
+            "  --trace-startup    print the startup timeline after the first frame\n");
+}
+
+static bool parse_long(const char* text, long min, long* out) {
+    char* end;
+    long value = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || value < min) {
+        return false;
+    }
+    *out = value;
+    return true;
+}
+
+static bool parse_options(int argc, char** argv, Options* options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        long number;
+        bool ok = true;
+
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+            usage(stdout);
+            exit(0);
+        } else if (strcmp(arg, "--headless") == 0) {
+            options->headless = true;
+            continue;
+        } else if (strcmp(arg, "--trace-startup") == 0) {
+            options->trace_startup = true;
+            continue;
+        } else if (value == NULL) {
+            ok = false;
+        } else if (strcmp(arg, "--resolution") == 0) {
+            // %n catches trailing text ("1280x720p") that sscanf would ignore
+            int consumed = 0;
+            ok = sscanf(value, "%dx%d%n", &options->width, &options->height, &consumed) == 2 &&
+                 value[consumed] == '\0' && options->width > 0 && options->height > 0;
+        } else if (strcmp(arg, "--backend") == 0) {
+            options->backend = value;
+        } else if (strcmp(arg, "--frames") == 0) {
+            ok = parse_long(value, 1, &options->frames);
+        } else if (strcmp(arg, "--seed") == 0) {
+            ok = parse_long(value, 0, &number);
+            if (ok) {
+                options->seed = (unsigned int)number;
+            }
+        } else if (strcmp(arg, "--replay") == 0) {
+            options->replay_path = value;
+        } else if (strcmp(arg, "--tick-rate") == 0) {
+            char* end;
+            options->tick_rate = strtod(value, &end);
+            ok = end != value && *end == '\0' && options->tick_rate > 0.0;
+        } else if (strcmp(arg, "--stats") == 0) {
+            options->stats_path = value;
+        } else {
+            fprintf(stderr, "Unknown option %s\n", arg);
+            return false;
+        }
+
+        if (!ok) {
+            fprintf(stderr, "Invalid or missing value for %s\n", arg);
+            return false;
+        }
+        i++;
+    }
+    return true;
+}
+
+static bool write_stats(const char* path, const Options* options, const RunStats* run) {
+    FILE* out = fopen(path, "w");
+    if (out == NULL) {
+        fprintf(stderr, "Could not open %s\n", path);
+        return false;
+    }
+
+    long frames = run->frames > 0 ? run->frames : 1;
+    fprintf(out, "{\n  \"backend\": \"%s\",\n  \"width\": %d,\n  \"height\": %d,\n", BACKEND_NAME, options->width,
+            options->height);
+    fprintf(out, "  \"seed\": %u,\n  \"tick_rate\": %.3f,\n  \"headless\": %s,\n", options->seed,
+            options->tick_rate, options->headless ? "true" : "false");
+    fprintf(out, "  \"frames\": %ld,\n  \"wall_seconds\": %.6f,\n  \"sim_seconds\": %.6f,\n", run->frames,
+            run->wall_seconds, run->sim_seconds);
+    fprintf(out, "  \"frame_ms_avg\": %.4f,\n  \"frame_ms_max\": %.4f,\n  \"cpu_ms_avg\": %.4f,\n",
+            run->frame_ms_total / frames, run->frame_ms_max, run->cpu_ms_total / frames);
+    fprintf(out, "  \"input_events\": %ld,\n  \"input_dropped\": %u,\n", run->input_events, input_dropped_events());
+
+    StartupStep steps[STARTUP_MAX_STEPS];
+    int step_count = startup_get_steps(steps, STARTUP_MAX_STEPS);
+    fprintf(out, "  \"first_frame_ms\": %.3f,\n  \"startup\": [\n", startup_first_frame_ms());
+    for (int i = 0; i < step_count; i++) {
+        fprintf(out, "    {\"name\": \"%s\", \"start_ms\": %.3f, \"end_ms\": %.3f}%s\n", steps[i].name,
+                steps[i].start_ms, steps[i].end_ms, i + 1 < step_count ? "," : "");
+    }
+    fprintf(out, "  ],\n");
+    fprintf(out, "  \"memory\": {\n");
+    for (int i = 0; i < MEM_TAG_COUNT; i++) {
+        MemTagStats stats = mem_get_stats((MemTag)i);
+        fprintf(out, "    \"%s\": {\"live_bytes\": %zu, \"peak_bytes\": %zu, \"total_allocs\": %u},\n",
+                mem_tag_name((MemTag)i), stats.live_bytes, stats.peak_bytes, stats.total_allocs);
+    }
+    MemTagStats total = mem_get_total();
+    fprintf(out, "    \"total\": {\"live_bytes\": %zu, \"peak_bytes\": %zu, \"total_allocs\": %u}\n  }\n}\n",
+            total.live_bytes, total.peak_bytes, total.total_allocs);
+    fclose(out);
+    return true;
+}
+
+int main(int argc, char** argv) {
+#ifndef BACKEND
+    (void)argc;
+    (void)argv;
+    printf("No graphics backend defined!\n");
+    return 1;
+#else
+    startup_begin();
+
+    Options options = {.width = 800, .height = 450};
+    if (!parse_options(argc, argv, &options)) {
+        usage(stderr);
+        return 1;
+    }
+    if (options.backend && strcmp(options.backend, BACKEND_NAME) != 0) {
+        fprintf(stderr, "This build uses the %s backend, not %s (rebuild with -Dgraphics=%s)\n", BACKEND_NAME,
+                options.backend, options.backend);
+        return 1;
+    }
+    if (BACKEND == GRAPHICS_NULL) {
+        options.headless = true;
+    }
+    if (options.headless && options.frames == 0) {
+        // Nothing could close a hidden window
+        fprintf(stderr, "Headless runs need --frames\n");
+        return 1;
+    }
+    if (options.replay_path && !input_load_replay(options.replay_path)) {
+        // Before the window opens, so a scripted run fails before it starts
+        fprintf(stderr, "Could not load replay %s\n", options.replay_path);
         return 1;
-    #endif
+    }
+
+    camera_set_shake_seed(options.seed);
+    srand(options.seed);
+
+    // Initialize graphics with the backend selected at compile time
+    if (options.headless) {
+        graphics_set_window_flags(GFX_WINDOW_HIDDEN | GFX_WINDOW_UNCAPPED);
+    }
+    // Only what the first frame needs runs here. Assets are read through
+    // loader.h as they're added and picked up on a later frame.
+    int graphics_step = startup_step_begin("graphics");
+    graphics_init(options.width, options.height, "Infinite Runner - " BACKEND_NAME " backend", BACKEND);
+    startup_step_end(graphics_step);
+    printf("Running with %s backend\n", BACKEND_NAME);
+
+    RunStats run = {0};
+    double start_time = graphics_get_time();
+    double last_time = start_time;
 
     // Main game loop
-    while (!graphics_should_close()) {
+    while (!graphics_should_close() && (options.frames == 0 || run.frames < options.frames)) {
+        perf_begin_frame();
+
+        // Fixed ticks make runs reproducible regardless of how fast frames go
+        double now = graphics_get_time();
+        double dt = options.tick_rate > 0.0 ? 1.0 / options.tick_rate : now - last_time;
+        last_time = now;
+        run.sim_seconds += dt;
+
+        // This frame's tick owns the input up to now; an event's time minus
+        // the previous tick's end is its sub-frame offset
+        input_replay_update(run.sim_seconds, now);
+        InputEvent event;
+        while (input_pop(now, &event)) {
+            run.input_events++;
+        }
+
         graphics_begin_frame();
-        
+
         // Clear screen with a dark blue color
         graphics_clear((GfxColor){20, 30, 80, 255});
-        
+
         // Draw some test rectangles
         graphics_draw_rectangle((GfxRectangle){100, 100, 50, 50}, COLOR_RED);
         graphics_draw_rectangle((GfxRectangle){200, 150, 80, 30}, COLOR_GREEN);
         graphics_draw_rectangle((GfxRectangle){350, 200, 100, 100}, COLOR_BLUE);
-        
-        
-        graphics_draw_text("Infinite Runner - Press ESC to close", 10, 10, 20, COLOR_WHITE);
-        graphics_draw_text("WASD to test (placeholder)", 10, 40, 16, COLOR_GRAY);
-        
+
+        graphics_draw_text_view(GFX_STRING("Infinite Runner - Press ESC to close"), 10, 10, 20, COLOR_WHITE);
+        graphics_draw_text_view(GFX_STRING("Space/W or A: jump, S or B: crouch, P or Start: pause"), 10, 40, 16,
+                                COLOR_GRAY);
+        for (int action = 0; action < INPUT_ACTION_COUNT; action++) {
+            if (input_is_down((InputAction)action)) {
+                graphics_draw_text(input_action_name((InputAction)action), 10 + action * 80, 64, 16, COLOR_WHITE);
+            }
+        }
+
+        perf_draw_hud(options.width - 250, 10);
+
         graphics_end_frame();
+        perf_end_frame();
+
+        if (run.frames == 0) {
+            startup_first_frame();
+            if (options.trace_startup || startup_first_frame_ms() > STARTUP_BUDGET_MS) {
+                startup_print(stderr);
+            }
+        }
+
+        PerfStats perf = perf_get_stats();
+        run.frames++;
+        run.frame_ms_total += perf.frame_ms;
+        run.cpu_ms_total += perf.cpu_ms;
+        if (perf.frame_ms > run.frame_ms_max) {
+            run.frame_ms_max = perf.frame_ms;
+        }
+    }
+    run.wall_seconds = graphics_get_time() - start_time;
+
+    int status = 0;
+    if (options.stats_path && !write_stats(options.stats_path, &options, &run)) {
+        status = 1;
     }
 
     // Cleanup
+    input_shutdown();
+    audio_shutdown();
     graphics_shutdown();
-    
+    loader_shutdown();
+
     printf("Game closed successfully\n");
-    return 0;
+    return status;
+#endif
 }
\ No newline at end of file
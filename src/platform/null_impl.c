@@ -0,0 +1,166 @@
+#ifdef GRAPHICS_BACKEND_NULL
+
+// Headless backend: no window and no rendering, everything above the
+// platform layer runs as usual. Used by the bench tool and headless runs.
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 199309L  // clock_gettime under -std=c99
+#endif
+
+#include "../engine/graphics.h"
+#include <stdio.h>
+#include <time.h>
+
+// Texture registry, handle = slot + 1 so that 0 means "no texture". Only
+// the size is kept, read from the BMP header.
+#define MAX_TEXTURES 64
+
+typedef struct {
+    bool loaded;
+    int width;
+    int height;
+} NullTexture;
+
+static NullTexture textures[MAX_TEXTURES];
+
+static int read_le32(const unsigned char* bytes) {
+    return (int)((unsigned int)bytes[0] | (unsigned int)bytes[1] << 8 | (unsigned int)bytes[2] << 16 |
+                 (unsigned int)bytes[3] << 24);
+}
+
+void platform_graphics_init(int width, int height, const char* title, unsigned int flags) {
+    (void)width;
+    (void)height;
+    (void)title;
+    (void)flags;
+}
+
+void platform_graphics_shutdown(void) {
+    for (int i = 0; i < MAX_TEXTURES; i++) {
+        textures[i].loaded = false;
+    }
+}
+
+bool platform_graphics_should_close(void) {
+    // Headless runs end on their own frame count
+    return false;
+}
+
+void platform_graphics_begin_frame(void) {
+}
+
+void platform_graphics_end_frame(void) {
+}
+
+double platform_graphics_get_time(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+void platform_graphics_clear(GfxColor color) {
+    (void)color;
+}
+
+void platform_graphics_draw_texture(int texture_id, GfxRectangle dest, GfxColor tint) {
+    (void)texture_id;
+    (void)dest;
+    (void)tint;
+}
+
+void platform_graphics_draw_geometry(int texture_id, const GfxVertex* vertices, int vertex_count, const int* indices,
+                                     int index_count) {
+    (void)texture_id;
+    (void)vertices;
+    (void)vertex_count;
+    (void)indices;
+    (void)index_count;
+}
+
+void platform_graphics_set_blend_mode(GfxBlendMode mode) {
+    (void)mode;
+}
+
+void platform_graphics_set_clip(const GfxRectangle* rect) {
+    (void)rect;
+}
+
+void platform_graphics_draw_text(const char* text, int x, int y, int size, GfxColor color) {
+    (void)text;
+    (void)x;
+    (void)y;
+    (void)size;
+    (void)color;
+}
+
+void platform_graphics_draw_text_view(const char* text, int length, int x, int y, int size, GfxColor color) {
+    (void)text;
+    (void)length;
+    (void)x;
+    (void)y;
+    (void)size;
+    (void)color;
+}
+
+// Fixed advance, roughly what the default fonts give
+int platform_graphics_measure_text_view(const char* text, int length, int size) {
+    (void)text;
+    return length * size / 2;
+}
+
+bool platform_graphics_get_texture_size(int texture_id, int* width, int* height) {
+    if (texture_id <= 0 || texture_id > MAX_TEXTURES || !textures[texture_id - 1].loaded) {
+        return false;
+    }
+    *width = textures[texture_id - 1].width;
+    *height = textures[texture_id - 1].height;
+    return true;
+}
+
+// Registers a texture from the first bytes of a BMP; name is only used in
+// messages
+static int texture_from_header(const unsigned char* header, size_t size, const char* name) {
+    int slot = 0;
+    while (slot < MAX_TEXTURES && textures[slot].loaded) {
+        slot++;
+    }
+    if (slot == MAX_TEXTURES) {
+        fprintf(stderr, "Texture registry full, cannot load %s\n", name);
+        return 0;
+    }
+    if (size < 26 || header[0] != 'B' || header[1] != 'M') {
+        fprintf(stderr, "Texture %s could not be loaded!\n", name);
+        return 0;
+    }
+
+    int height = read_le32(&header[22]);
+    textures[slot].loaded = true;
+    textures[slot].width = read_le32(&header[18]);
+    textures[slot].height = height < 0 ? -height : height;  // negative for top-down BMPs
+    return slot + 1;
+}
+
+int platform_graphics_load_texture(const char* filename, bool premultiply) {
+    (void)premultiply;
+    unsigned char header[26];
+    FILE* file = fopen(filename, "rb");
+    size_t read = file ? fread(header, 1, sizeof(header), file) : 0;
+    if (file) {
+        fclose(file);
+    }
+    return texture_from_header(header, read, filename);
+}
+
+int platform_graphics_load_texture_memory(const char* name, const unsigned char* data, size_t size,
+                                          bool premultiply) {
+    (void)premultiply;
+    return texture_from_header(data, size, name);
+}
+
+void platform_graphics_unload_texture(int texture_id) {
+    if (texture_id > 0 && texture_id <= MAX_TEXTURES) {
+        textures[texture_id - 1].loaded = false;
+    }
+}
+
+#endif // GRAPHICS_BACKEND_NULL
\ No newline at end of file
@@ -1,7 +1,28 @@
 #ifdef GRAPHICS_BACKEND_RAYLIB
 
 #include "../engine/graphics.h"
+#include "../engine/input.h"
+#include "../engine/perf.h"
+#include "../engine/startup.h"
 #include <raylib.h>
+#include <rlgl.h>
+#include <math.h>
+#include <stddef.h>
+
+// Texture registry, handle = slot + 1 so that 0 means "no texture"
+#define MAX_TEXTURES 64
+static Texture2D textures[MAX_TEXTURES];
+
+// Triangles submitted per rlBegin/rlEnd so a large mesh never overflows
+// the rlgl batch
+#define GEOMETRY_CHUNK_VERTICES 3072
+
+static const Texture2D* texture_from_id(int texture_id) {
+    if (texture_id <= 0 || texture_id > MAX_TEXTURES || textures[texture_id - 1].id == 0) {
+        return NULL;
+    }
+    return &textures[texture_id - 1];
+}
 
 // Convert our GfxColor to Raylib Color
 static Color raylib_color_from_gfx_color(GfxColor color) {
@@ -13,16 +34,90 @@ static Rectangle raylib_rectangle_from_gfx_rectangle(GfxRectangle rect) {
     return (Rectangle){rect.x, rect.y, rect.width, rect.height};
 }
 
-void platform_graphics_init(int width, int height, const char* title) {
+void platform_graphics_init(int width, int height, const char* title, unsigned int flags) {
+    if (flags & GFX_WINDOW_HIDDEN) {
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    }
+    int step = startup_step_begin("InitWindow");
     InitWindow(width, height, title);
-    SetTargetFPS(60);
+    startup_step_end(step);
+    SetTargetFPS((flags & GFX_WINDOW_UNCAPPED) ? 0 : 60);
 }
 
 void platform_graphics_shutdown(void) {
+    for (int i = 0; i < MAX_TEXTURES; i++) {
+        if (textures[i].id != 0) {
+            UnloadTexture(textures[i]);
+            textures[i] = (Texture2D){0};
+        }
+    }
     CloseWindow();
 }
 
+#define MAX_GAMEPADS 4
+
+typedef struct {
+    InputAction action;
+    int keys[3];  // 0-terminated
+    int buttons[2];
+} ActionBinding;
+
+static const ActionBinding bindings[] = {
+    {INPUT_ACTION_JUMP, {KEY_SPACE, KEY_UP, KEY_W}, {GAMEPAD_BUTTON_RIGHT_FACE_DOWN, GAMEPAD_BUTTON_LEFT_FACE_UP}},
+    {INPUT_ACTION_CROUCH, {KEY_DOWN, KEY_S, 0}, {GAMEPAD_BUTTON_RIGHT_FACE_RIGHT, GAMEPAD_BUTTON_LEFT_FACE_DOWN}},
+    {INPUT_ACTION_PAUSE, {KEY_P, 0, 0}, {GAMEPAD_BUTTON_MIDDLE_RIGHT, 0}},
+};
+
+// Left stick down crouches, with hysteresis so a resting stick doesn't chatter
+#define STICK_PRESS 0.5f
+#define STICK_RELEASE 0.25f
+
+static bool stick_crouch[MAX_GAMEPADS];
+
+// Raylib polls input once per frame (in EndDrawing) and keeps no event
+// times, so everything seen here is stamped with the time of this poll
+static void poll_input(void) {
+    double now = GetTime();
+    if (IsKeyPressed(KEY_F3)) {
+        perf_toggle_hud();
+    }
+    for (int pad = 0; pad < MAX_GAMEPADS; pad++) {
+        if (!IsGamepadAvailable(pad)) {
+            continue;
+        }
+        float y = GetGamepadAxisMovement(pad, GAMEPAD_AXIS_LEFT_Y);
+        bool crouch = stick_crouch[pad] ? y > STICK_RELEASE : y > STICK_PRESS;
+        if (crouch != stick_crouch[pad]) {
+            stick_crouch[pad] = crouch;
+            input_push(INPUT_ACTION_CROUCH, crouch, now, INPUT_SOURCE_GAMEPAD);
+        }
+    }
+    for (size_t b = 0; b < sizeof(bindings) / sizeof(bindings[0]); b++) {
+        const ActionBinding* binding = &bindings[b];
+        for (int k = 0; k < 3 && binding->keys[k] != 0; k++) {
+            if (IsKeyPressed(binding->keys[k])) {
+                input_push(binding->action, true, now, INPUT_SOURCE_KEYBOARD);
+            } else if (IsKeyReleased(binding->keys[k])) {
+                input_push(binding->action, false, now, INPUT_SOURCE_KEYBOARD);
+            }
+        }
+        for (int pad = 0; pad < MAX_GAMEPADS; pad++) {
+            if (!IsGamepadAvailable(pad)) {
+                continue;
+            }
+            for (int k = 0; k < 2 && binding->buttons[k] != 0; k++) {
+                if (IsGamepadButtonPressed(pad, binding->buttons[k])) {
+                    input_push(binding->action, true, now, INPUT_SOURCE_GAMEPAD);
+                } else if (IsGamepadButtonReleased(pad, binding->buttons[k])) {
+                    input_push(binding->action, false, now, INPUT_SOURCE_GAMEPAD);
+                }
+            }
+        }
+    }
+}
+
 bool platform_graphics_should_close(void) {
+    poll_input();
     return WindowShouldClose();
 }
 
@@ -34,22 +129,77 @@ void platform_graphics_end_frame(void) {
     EndDrawing();
 }
 
+double platform_graphics_get_time(void) {
+    return GetTime();
+}
+
 void platform_graphics_clear(GfxColor color) {
     ClearBackground(raylib_color_from_gfx_color(color));
 }
 
-void platform_graphics_draw_rectangle(GfxRectangle rect, GfxColor color) {
-    Rectangle raylib_rect = raylib_rectangle_from_gfx_rectangle(rect);
-    Color raylib_color = raylib_color_from_gfx_color(color);
-    DrawRectangleRec(raylib_rect, raylib_color);
+void platform_graphics_draw_texture(int texture_id, GfxRectangle dest, GfxColor tint) {
+    const Texture2D* texture = texture_from_id(texture_id);
+    if (texture == NULL) {
+        return;
+    }
+    Rectangle source = {0.0f, 0.0f, (float)texture->width, (float)texture->height};
+    DrawTexturePro(*texture, source, raylib_rectangle_from_gfx_rectangle(dest), (Vector2){0.0f, 0.0f}, 0.0f,
+                   raylib_color_from_gfx_color(tint));
 }
 
-void platform_graphics_draw_texture(int texture_id, GfxRectangle dest, GfxColor tint) {
-    // For now, we'll implement this as a placeholder
-    // In a full implementation, we'd maintain a texture registry
-    (void)texture_id;
-    (void)dest;
-    (void)tint;
+void platform_graphics_set_clip(const GfxRectangle* rect) {
+    if (rect == NULL) {
+        EndScissorMode();
+        return;
+    }
+    // Round outwards so partially covered pixels are kept
+    int x0 = (int)floorf(rect->x);
+    int y0 = (int)floorf(rect->y);
+    int x1 = (int)ceilf(rect->x + rect->width);
+    int y1 = (int)ceilf(rect->y + rect->height);
+    BeginScissorMode(x0, y0, x1 - x0, y1 - y0);
+}
+
+void platform_graphics_set_blend_mode(GfxBlendMode mode) {
+    switch (mode) {
+        case GFX_BLEND_PREMULTIPLIED:
+            BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+            break;
+        case GFX_BLEND_ADDITIVE:
+            BeginBlendMode(BLEND_ADDITIVE);
+            break;
+        case GFX_BLEND_MULTIPLY:
+            BeginBlendMode(BLEND_MULTIPLIED);
+            break;
+        default:
+            BeginBlendMode(BLEND_ALPHA);
+            break;
+    }
+}
+
+static void rlgl_vertex(const GfxVertex* v) {
+    rlColor4ub(v->color.r, v->color.g, v->color.b, v->color.a);
+    rlTexCoord2f(v->u, v->v);
+    rlVertex2f(v->x, v->y);
+}
+
+void platform_graphics_draw_geometry(int texture_id, const GfxVertex* vertices, int vertex_count, const int* indices,
+                                     int index_count) {
+    const Texture2D* texture = texture_from_id(texture_id);
+    int count = indices ? index_count : vertex_count;
+    count -= count % 3;
+
+    rlSetTexture(texture ? texture->id : rlGetTextureIdDefault());
+    for (int start = 0; start < count; start += GEOMETRY_CHUNK_VERTICES) {
+        int end = start + GEOMETRY_CHUNK_VERTICES < count ? start + GEOMETRY_CHUNK_VERTICES : count;
+        rlCheckRenderBatchLimit(end - start);
+        rlBegin(RL_TRIANGLES);
+        for (int i = start; i < end; i++) {
+            rlgl_vertex(&vertices[indices ? indices[i] : i]);
+        }
+        rlEnd();
+    }
+    rlSetTexture(0);
 }
 
 void platform_graphics_draw_text(const char* text, int x, int y, int size, GfxColor color) {
@@ -57,17 +207,168 @@ void platform_graphics_draw_text(const char* text, int x, int y, int size, GfxCo
     DrawText(text, x, y, size, raylib_color);
 }
 
-int platform_graphics_load_texture(const char* filename) {
-    // For now, return a dummy texture ID
-    // In a full implementation, we'd load the texture and return a handle
-    (void)filename;
+// Length of the UTF-8 sequence starting with this byte
+static int utf8_sequence_length(unsigned char lead) {
+    if (lead < 0x80) return 1;
+    if ((lead & 0xE0) == 0xC0) return 2;
+    if ((lead & 0xF0) == 0xE0) return 3;
+    if ((lead & 0xF8) == 0xF0) return 4;
     return 1;
 }
 
+// Decodes one codepoint without reading past the end of the view;
+// truncated sequences come back as '?'
+static int text_view_next_codepoint(const char* text, int remaining, int* byte_count) {
+    int n = utf8_sequence_length((unsigned char)text[0]);
+    if (n > remaining) {
+        *byte_count = remaining;
+        return '?';
+    }
+    if (n == 1) {
+        *byte_count = 1;
+        return (unsigned char)text[0];
+    }
+    return GetCodepointNext(text, byte_count);
+}
+
+// Same layout as DrawText/DrawTextEx with the default font, driven by the
+// view length instead of a NUL terminator
+void platform_graphics_draw_text_view(const char* text, int length, int x, int y, int size, GfxColor color) {
+    Font font = GetFontDefault();
+    if (font.texture.id == 0) {
+        return;
+    }
+    if (size < 10) {
+        size = 10;
+    }
+
+    Color raylib_color = raylib_color_from_gfx_color(color);
+    float spacing = (float)(size / 10);
+    float scale = (float)size / (float)font.baseSize;
+    float offset_x = 0.0f;
+    float offset_y = 0.0f;
+
+    for (int i = 0; i < length;) {
+        int byte_count = 0;
+        int codepoint = text_view_next_codepoint(&text[i], length - i, &byte_count);
+        int index = GetGlyphIndex(font, codepoint);
+
+        if (codepoint == '\n') {
+            offset_y += (float)size + 2.0f;
+            offset_x = 0.0f;
+        } else {
+            if (codepoint != ' ' && codepoint != '\t') {
+                DrawTextCodepoint(font, codepoint, (Vector2){(float)x + offset_x, (float)y + offset_y}, (float)size,
+                                  raylib_color);
+            }
+            float advance = font.glyphs[index].advanceX ? (float)font.glyphs[index].advanceX : font.recs[index].width;
+            offset_x += advance * scale + spacing;
+        }
+        i += byte_count;
+    }
+}
+
+// Width of the longest line, matching MeasureText
+int platform_graphics_measure_text_view(const char* text, int length, int size) {
+    Font font = GetFontDefault();
+    if (font.texture.id == 0) {
+        return 0;
+    }
+    if (size < 10) {
+        size = 10;
+    }
+
+    float spacing = (float)(size / 10);
+    float scale = (float)size / (float)font.baseSize;
+    float line_width = 0.0f;
+    float max_width = 0.0f;
+    int line_glyphs = 0;
+    int max_glyphs = 0;
+
+    for (int i = 0; i < length;) {
+        int byte_count = 0;
+        int codepoint = text_view_next_codepoint(&text[i], length - i, &byte_count);
+        int index = GetGlyphIndex(font, codepoint);
+
+        if (codepoint == '\n') {
+            line_width = 0.0f;
+            line_glyphs = 0;
+        } else {
+            line_width += font.glyphs[index].advanceX ? (float)font.glyphs[index].advanceX
+                                                      : font.recs[index].width + (float)font.glyphs[index].offsetX;
+            line_glyphs++;
+        }
+        if (line_width > max_width) {
+            max_width = line_width;
+            max_glyphs = line_glyphs;
+        }
+        i += byte_count;
+    }
+
+    if (max_glyphs == 0) {
+        return 0;
+    }
+    return (int)(max_width * scale + (float)(max_glyphs - 1) * spacing);
+}
+
+bool platform_graphics_get_texture_size(int texture_id, int* width, int* height) {
+    const Texture2D* texture = texture_from_id(texture_id);
+    if (texture == NULL) {
+        return false;
+    }
+    *width = texture->width;
+    *height = texture->height;
+    return true;
+}
+
+// Uploads image into a free texture slot and unloads it; name is only used
+// in messages
+static int texture_from_image(Image image, bool premultiply, const char* name) {
+    int slot = 0;
+    while (slot < MAX_TEXTURES && textures[slot].id != 0) {
+        slot++;
+    }
+    if (slot == MAX_TEXTURES) {
+        TraceLog(LOG_WARNING, "Texture registry full, cannot load %s", name);
+        UnloadImage(image);
+        return 0;
+    }
+
+    if (premultiply) {
+        ImageAlphaPremultiply(&image);
+    }
+    Texture2D texture = LoadTextureFromImage(image);
+    UnloadImage(image);
+    if (texture.id == 0) {
+        return 0;
+    }
+    textures[slot] = texture;
+    return slot + 1;
+}
+
+int platform_graphics_load_texture(const char* filename, bool premultiply) {
+    Image image = LoadImage(filename);
+    if (image.data == NULL) {
+        return 0;
+    }
+    return texture_from_image(image, premultiply, filename);
+}
+
+// The file type comes from the name's extension, as with LoadImage
+int platform_graphics_load_texture_memory(const char* name, const unsigned char* data, size_t size,
+                                          bool premultiply) {
+    Image image = LoadImageFromMemory(GetFileExtension(name), data, (int)size);
+    if (image.data == NULL) {
+        return 0;
+    }
+    return texture_from_image(image, premultiply, name);
+}
+
 void platform_graphics_unload_texture(int texture_id) {
-    // For now, this is a no-op
-    // In a full implementation, we'd unload the texture
-    (void)texture_id;
+    if (texture_from_id(texture_id)) {
+        UnloadTexture(textures[texture_id - 1]);
+        textures[texture_id - 1] = (Texture2D){0};
+    }
 }
 
 #endif // GRAPHICS_BACKEND_RAYLIB
\ No newline at end of file
@@ -1,36 +1,102 @@
 #ifdef GRAPHICS_BACKEND_SDL3
 
 #include "../engine/graphics.h"
+#include "../engine/input.h"
+#include "../engine/mem.h"
+#include "../engine/perf.h"
+#include "../engine/startup.h"
 #include <SDL3/SDL.h>
 #include <stdbool.h>
 
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+
+extern void web_audio_pump(void);
+#endif
+
 static SDL_Window* window = NULL;
 static SDL_Renderer* renderer = NULL;
 static bool should_close = false;
 
-void platform_graphics_init(int width, int height, const char* title) {
-    if (!SDL_Init(SDL_INIT_VIDEO)) {
+// Texture registry, handle = slot + 1 so that 0 means "no texture"
+#define MAX_TEXTURES 64
+static SDL_Texture* textures[MAX_TEXTURES];
+
+// Scratch space for converting GfxVertex to SDL_Vertex
+static SDL_Vertex* geometry_vertices = NULL;
+static int geometry_capacity = 0;
+
+// Applied to the renderer for untextured draws and to each texture as it is drawn
+static SDL_BlendMode blend_mode = SDL_BLENDMODE_BLEND;
+
+static SDL_Texture* texture_from_id(int texture_id) {
+    if (texture_id <= 0 || texture_id > MAX_TEXTURES) {
+        return NULL;
+    }
+    return textures[texture_id - 1];
+}
+
+void platform_graphics_init(int width, int height, const char* title, unsigned int flags) {
+#ifdef __EMSCRIPTEN__
+    // Worker mode (web/worker.html): game-worker.js registers the
+    // transferred OffscreenCanvas as #canvas. Keys are forwarded by the
+    // page, but SDL's keyboard listener has no window to attach to here
+    if (EM_ASM_INT({ return typeof WorkerGlobalScope !== "undefined" && self instanceof WorkerGlobalScope; })) {
+        SDL_SetHint(SDL_HINT_EMSCRIPTEN_CANVAS_SELECTOR, "#canvas");
+        SDL_SetHint(SDL_HINT_EMSCRIPTEN_KEYBOARD_ELEMENT, "#canvas");
+    }
+#endif
+    int step = startup_step_begin("SDL_Init");
+    bool initialized = SDL_Init(SDL_INIT_VIDEO);
+    startup_step_end(step);
+    if (!initialized) {
         SDL_Log("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
         return;
     }
 
-    window = SDL_CreateWindow(title, width, height, SDL_WINDOW_RESIZABLE);
+    // Optional: there is no Gamepad API in a web worker (web/worker.html)
+    step = startup_step_begin("gamepad");
+    if (!SDL_InitSubSystem(SDL_INIT_GAMEPAD)) {
+        SDL_Log("Gamepads unavailable: %s\n", SDL_GetError());
+    }
+    startup_step_end(step);
+
+    // The renderer is created without vsync, so GFX_WINDOW_UNCAPPED needs nothing here
+    SDL_WindowFlags window_flags = SDL_WINDOW_RESIZABLE;
+    if (flags & GFX_WINDOW_HIDDEN) {
+        window_flags |= SDL_WINDOW_HIDDEN;
+    }
+    step = startup_step_begin("window");
+    window = SDL_CreateWindow(title, width, height, window_flags);
+    startup_step_end(step);
     if (window == NULL) {
         SDL_Log("Window could not be created! SDL_Error: %s\n", SDL_GetError());
         SDL_Quit();
         return;
     }
 
+    step = startup_step_begin("renderer");
     renderer = SDL_CreateRenderer(window, NULL);
+    startup_step_end(step);
     if (renderer == NULL) {
         SDL_Log("Renderer could not be created! SDL_Error: %s\n", SDL_GetError());
         SDL_DestroyWindow(window);
         SDL_Quit();
         return;
     }
+    SDL_SetRenderDrawBlendMode(renderer, blend_mode);
 }
 
 void platform_graphics_shutdown(void) {
+    for (int i = 0; i < MAX_TEXTURES; i++) {
+        if (textures[i]) {
+            SDL_DestroyTexture(textures[i]);
+            textures[i] = NULL;
+        }
+    }
+    mem_free(geometry_vertices);
+    geometry_vertices = NULL;
+    geometry_capacity = 0;
     if (renderer) {
         SDL_DestroyRenderer(renderer);
         renderer = NULL;
@@ -42,13 +108,149 @@ void platform_graphics_shutdown(void) {
     SDL_Quit();
 }
 
+static bool key_action(SDL_Keycode key, InputAction* action) {
+    switch (key) {
+        case SDLK_SPACE:
+        case SDLK_UP:
+        case SDLK_W:
+            *action = INPUT_ACTION_JUMP;
+            return true;
+        case SDLK_DOWN:
+        case SDLK_S:
+            *action = INPUT_ACTION_CROUCH;
+            return true;
+        case SDLK_P:
+            *action = INPUT_ACTION_PAUSE;
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool gamepad_action(Uint8 button, InputAction* action) {
+    switch (button) {
+        case SDL_GAMEPAD_BUTTON_SOUTH:
+        case SDL_GAMEPAD_BUTTON_DPAD_UP:
+            *action = INPUT_ACTION_JUMP;
+            return true;
+        case SDL_GAMEPAD_BUTTON_EAST:
+        case SDL_GAMEPAD_BUTTON_DPAD_DOWN:
+            *action = INPUT_ACTION_CROUCH;
+            return true;
+        case SDL_GAMEPAD_BUTTON_START:
+            *action = INPUT_ACTION_PAUSE;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Left stick down crouches, with hysteresis so a resting stick doesn't chatter
+#define STICK_PRESS 16000
+#define STICK_RELEASE 8000
+
+// Stick state per pad, keyed by joystick instance ID (0 = free slot), so
+// one pad's resting stick can't release another's crouch
+#define MAX_GAMEPADS 4
+
+static struct {
+    SDL_JoystickID id;
+    bool crouch;
+} sticks[MAX_GAMEPADS];
+
+// The pad's entry, claiming a free one on first use; NULL when all are taken
+static bool* stick_crouch(SDL_JoystickID id) {
+    int free_slot = -1;
+    for (int i = 0; i < MAX_GAMEPADS; i++) {
+        if (sticks[i].id == id) {
+            return &sticks[i].crouch;
+        }
+        if (sticks[i].id == 0 && free_slot < 0) {
+            free_slot = i;
+        }
+    }
+    if (free_slot < 0) {
+        return NULL;
+    }
+    sticks[free_slot].id = id;
+    sticks[free_slot].crouch = false;
+    return &sticks[free_slot].crouch;
+}
+
+#ifdef __EMSCRIPTEN__
+// Worker mode (web/worker.html) gets no DOM events; the page forwards them
+// through a ring that Module.pumpInput drains into web_key_event and
+// web_pointer_event
+static void web_input_pump(void) {
+    EM_ASM({
+        if (Module.pumpInput) {
+            Module.pumpInput();
+        }
+    });
+}
+#endif
+
+// Events carry SDL_GetTicksNS timestamps from when SDL received them, the
+// same clock as platform_graphics_get_time, so the input queue gets
+// sub-frame timing rather than the time of this poll.
 bool platform_graphics_should_close(void) {
     SDL_Event e;
+    InputAction action;
+#ifdef __EMSCRIPTEN__
+    web_input_pump();
+#endif
     while (SDL_PollEvent(&e)) {
-        if (e.type == SDL_EVENT_QUIT) {
-            should_close = true;
-        } else if (e.type == SDL_EVENT_KEY_DOWN && e.key.key == SDLK_ESCAPE) {
-            should_close = true;
+        double time = (double)e.common.timestamp / 1e9;
+        switch (e.type) {
+            case SDL_EVENT_QUIT:
+                should_close = true;
+                break;
+            case SDL_EVENT_KEY_DOWN:
+            case SDL_EVENT_KEY_UP:
+                if (e.key.key == SDLK_ESCAPE) {
+                    should_close = true;
+                } else if (e.key.key == SDLK_F3) {
+                    if (e.type == SDL_EVENT_KEY_DOWN && !e.key.repeat) {
+                        perf_toggle_hud();
+                    }
+                } else if (!e.key.repeat && key_action(e.key.key, &action)) {
+                    input_push(action, e.type == SDL_EVENT_KEY_DOWN, time, INPUT_SOURCE_KEYBOARD);
+                }
+                break;
+            case SDL_EVENT_GAMEPAD_ADDED:
+                SDL_OpenGamepad(e.gdevice.which);
+                break;
+            case SDL_EVENT_GAMEPAD_REMOVED:
+                SDL_CloseGamepad(SDL_GetGamepadFromID(e.gdevice.which));
+                for (int i = 0; i < MAX_GAMEPADS; i++) {
+                    if (sticks[i].id == e.gdevice.which) {
+                        // Unplugged mid-crouch: release it so it isn't held forever
+                        if (sticks[i].crouch) {
+                            input_push(INPUT_ACTION_CROUCH, false, time, INPUT_SOURCE_GAMEPAD);
+                        }
+                        sticks[i].id = 0;
+                        sticks[i].crouch = false;
+                    }
+                }
+                break;
+            case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+            case SDL_EVENT_GAMEPAD_BUTTON_UP:
+                if (gamepad_action(e.gbutton.button, &action)) {
+                    input_push(action, e.type == SDL_EVENT_GAMEPAD_BUTTON_DOWN, time, INPUT_SOURCE_GAMEPAD);
+                }
+                break;
+            case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+                bool* stick = e.gaxis.axis == SDL_GAMEPAD_AXIS_LEFTY ? stick_crouch(e.gaxis.which) : NULL;
+                if (stick != NULL) {
+                    bool crouch = *stick ? e.gaxis.value > STICK_RELEASE : e.gaxis.value > STICK_PRESS;
+                    if (crouch != *stick) {
+                        *stick = crouch;
+                        input_push(INPUT_ACTION_CROUCH, crouch, time, INPUT_SOURCE_GAMEPAD);
+                    }
+                }
+                break;
+            default:
+                break;
         }
     }
     return should_close;
@@ -60,25 +262,114 @@ void platform_graphics_begin_frame(void) {
 
 void platform_graphics_end_frame(void) {
     SDL_RenderPresent(renderer);
+#ifdef __EMSCRIPTEN__
+    web_audio_pump();
+#endif
 }
 
+double platform_graphics_get_time(void) {
+    return (double)SDL_GetTicksNS() / 1e9;
+}
+
+#ifdef __EMSCRIPTEN__
+// Called from web/index.html for every pointer event sample, coalesced ones
+// included. age_ms is how long before the call the sample was taken, which
+// places it on our clock without assuming SDL's and the page's time origins
+// agree.
+EMSCRIPTEN_KEEPALIVE void web_pointer_event(int phase, int pointer_id, float x, float y, double age_ms) {
+    input_pointer((InputPointerPhase)phase, pointer_id, x, y, platform_graphics_get_time() - age_ms / 1000.0);
+}
+
+// Worker mode only: keys forwarded by web/worker.html as SDL keycodes, so
+// they map to actions exactly like SDL's own key events
+EMSCRIPTEN_KEEPALIVE void web_key_event(int key, int down, double age_ms) {
+    InputAction action;
+    if (key == SDLK_ESCAPE) {
+        should_close = true;
+    } else if (key == SDLK_F3) {
+        if (down) {
+            perf_toggle_hud();
+        }
+    } else if (key_action((SDL_Keycode)key, &action)) {
+        input_push(action, down != 0, platform_graphics_get_time() - age_ms / 1000.0, INPUT_SOURCE_KEYBOARD);
+    }
+}
+#endif
+
 void platform_graphics_clear(GfxColor color) {
     SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
     SDL_RenderClear(renderer);
 }
 
-void platform_graphics_draw_rectangle(GfxRectangle rect, GfxColor color) {
-    SDL_FRect sdl_rect = {rect.x, rect.y, rect.width, rect.height};
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-    SDL_RenderFillRect(renderer, &sdl_rect);
+void platform_graphics_draw_texture(int texture_id, GfxRectangle dest, GfxColor tint) {
+    SDL_Texture* texture = texture_from_id(texture_id);
+    if (texture == NULL) {
+        return;
+    }
+    SDL_FRect sdl_dest = {dest.x, dest.y, dest.width, dest.height};
+    SDL_SetTextureBlendMode(texture, blend_mode);
+    SDL_SetTextureColorMod(texture, tint.r, tint.g, tint.b);
+    SDL_SetTextureAlphaMod(texture, tint.a);
+    SDL_RenderTexture(renderer, texture, NULL, &sdl_dest);
 }
 
-void platform_graphics_draw_texture(int texture_id, GfxRectangle dest, GfxColor tint) {
-    // For now, we'll implement this as a placeholder
-    // In a full implementation, we'd maintain a texture registry
-    (void)texture_id;
-    (void)dest;
-    (void)tint;
+void platform_graphics_draw_geometry(int texture_id, const GfxVertex* vertices, int vertex_count, const int* indices,
+                                     int index_count) {
+    if (vertex_count > geometry_capacity) {
+        SDL_Vertex* grown = mem_realloc(MEM_TAG_GRAPHICS, geometry_vertices, (size_t)vertex_count * sizeof(SDL_Vertex));
+        if (grown == NULL) {
+            return;
+        }
+        geometry_vertices = grown;
+        geometry_capacity = vertex_count;
+    }
+
+    const float inv = 1.0f / 255.0f;
+    for (int i = 0; i < vertex_count; i++) {
+        const GfxVertex* v = &vertices[i];
+        geometry_vertices[i] = (SDL_Vertex){
+            {v->x, v->y},
+            {v->color.r * inv, v->color.g * inv, v->color.b * inv, v->color.a * inv},
+            {v->u, v->v},
+        };
+    }
+    SDL_Texture* texture = texture_from_id(texture_id);
+    if (texture) {
+        SDL_SetTextureBlendMode(texture, blend_mode);
+    }
+    SDL_RenderGeometry(renderer, texture, geometry_vertices, vertex_count, indices, indices ? index_count : 0);
+}
+
+void platform_graphics_set_clip(const GfxRectangle* rect) {
+    if (rect == NULL) {
+        SDL_SetRenderClipRect(renderer, NULL);
+        return;
+    }
+    // Round outwards so partially covered pixels are kept
+    int x0 = (int)SDL_floorf(rect->x);
+    int y0 = (int)SDL_floorf(rect->y);
+    int x1 = (int)SDL_ceilf(rect->x + rect->width);
+    int y1 = (int)SDL_ceilf(rect->y + rect->height);
+    SDL_Rect clip = {x0, y0, x1 - x0, y1 - y0};
+    SDL_SetRenderClipRect(renderer, &clip);
+}
+
+void platform_graphics_set_blend_mode(GfxBlendMode mode) {
+    switch (mode) {
+        case GFX_BLEND_PREMULTIPLIED:
+            blend_mode = SDL_BLENDMODE_BLEND_PREMULTIPLIED;
+            break;
+        case GFX_BLEND_ADDITIVE:
+            blend_mode = SDL_BLENDMODE_ADD;
+            break;
+        case GFX_BLEND_MULTIPLY:
+            blend_mode = SDL_BLENDMODE_MUL;
+            break;
+        default:
+            blend_mode = SDL_BLENDMODE_BLEND;
+            break;
+    }
+    SDL_SetRenderDrawBlendMode(renderer, blend_mode);
 }
 
 void platform_graphics_draw_text(const char* text, int x, int y, int size, GfxColor color) {
@@ -94,17 +385,122 @@ void platform_graphics_draw_text(const char* text, int x, int y, int size, GfxCo
     SDL_RenderDebugText(renderer, x, y, text);
 }
 
-int platform_graphics_load_texture(const char* filename) {
-    // For now, return a dummy texture ID
-    // In a full implementation, we'd load the texture and return a handle
-    (void)filename;
-    return 1;
+// SDL_RenderDebugText only takes NUL-terminated strings, so views are copied
+// through a small stack buffer in chunks that never split a UTF-8 sequence
+#define TEXT_VIEW_CHUNK 128
+
+static int utf8_codepoint_count(const char* text, int length) {
+    int count = 0;
+    for (int i = 0; i < length; i++) {
+        if (((unsigned char)text[i] & 0xC0) != 0x80) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void platform_graphics_draw_text_view(const char* text, int length, int x, int y, int size, GfxColor color) {
+    (void)size;
+    char chunk[TEXT_VIEW_CHUNK + 1];
+    float pen_x = (float)x;
+
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    while (length > 0) {
+        int n = length < TEXT_VIEW_CHUNK ? length : TEXT_VIEW_CHUNK;
+        // Back off to the start of a UTF-8 sequence if we'd cut one in half
+        while (n < length && n > 0 && ((unsigned char)text[n] & 0xC0) == 0x80) {
+            n--;
+        }
+        if (n == 0) {
+            n = length < TEXT_VIEW_CHUNK ? length : TEXT_VIEW_CHUNK;
+        }
+
+        SDL_memcpy(chunk, text, (size_t)n);
+        chunk[n] = '\0';
+        SDL_RenderDebugText(renderer, pen_x, (float)y, chunk);
+
+        pen_x += (float)(utf8_codepoint_count(text, n) * SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE);
+        text += n;
+        length -= n;
+    }
+}
+
+int platform_graphics_measure_text_view(const char* text, int length, int size) {
+    // The debug font is fixed size
+    (void)size;
+    return utf8_codepoint_count(text, length) * SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
+}
+
+bool platform_graphics_get_texture_size(int texture_id, int* width, int* height) {
+    SDL_Texture* texture = texture_from_id(texture_id);
+    float w = 0.0f;
+    float h = 0.0f;
+    if (texture == NULL || !SDL_GetTextureSize(texture, &w, &h)) {
+        return false;
+    }
+    *width = (int)w;
+    *height = (int)h;
+    return true;
+}
+
+// Uploads surface into a free texture slot and destroys it; name is only
+// used in messages
+static int texture_from_surface(SDL_Surface* surface, bool premultiply, const char* name) {
+    int slot = 0;
+    while (slot < MAX_TEXTURES && textures[slot] != NULL) {
+        slot++;
+    }
+    if (slot == MAX_TEXTURES) {
+        SDL_Log("Texture registry full, cannot load %s\n", name);
+        SDL_DestroySurface(surface);
+        return 0;
+    }
+
+    if (premultiply) {
+        SDL_Surface* rgba = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+        SDL_DestroySurface(surface);
+        if (rgba == NULL || !SDL_PremultiplySurfaceAlpha(rgba, false)) {
+            SDL_Log("Texture %s could not be premultiplied! SDL_Error: %s\n", name, SDL_GetError());
+            SDL_DestroySurface(rgba);
+            return 0;
+        }
+        surface = rgba;
+    }
+    textures[slot] = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_DestroySurface(surface);
+    if (textures[slot] == NULL) {
+        SDL_Log("Texture %s could not be created! SDL_Error: %s\n", name, SDL_GetError());
+        return 0;
+    }
+    return slot + 1;
+}
+
+// Core SDL3 only decodes BMP; other formats need SDL_image
+int platform_graphics_load_texture(const char* filename, bool premultiply) {
+    SDL_Surface* surface = SDL_LoadBMP(filename);
+    if (surface == NULL) {
+        SDL_Log("Texture %s could not be loaded! SDL_Error: %s\n", filename, SDL_GetError());
+        return 0;
+    }
+    return texture_from_surface(surface, premultiply, filename);
+}
+
+int platform_graphics_load_texture_memory(const char* name, const unsigned char* data, size_t size,
+                                          bool premultiply) {
+    SDL_Surface* surface = SDL_LoadBMP_IO(SDL_IOFromConstMem(data, size), true);
+    if (surface == NULL) {
+        SDL_Log("Texture %s could not be decoded! SDL_Error: %s\n", name, SDL_GetError());
+        return 0;
+    }
+    return texture_from_surface(surface, premultiply, name);
 }
 
 void platform_graphics_unload_texture(int texture_id) {
-    // For now, this is a no-op
-    // In a full implementation, we'd unload the texture
-    (void)texture_id;
+    SDL_Texture* texture = texture_from_id(texture_id);
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        textures[texture_id - 1] = NULL;
+    }
 }
 
 #endif // GRAPHICS_BACKEND_SDL3
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifdef __EMSCRIPTEN__
+
+// Web audio output. The page runs an AudioWorklet that plays from a ring
+// buffer on the audio rendering thread; each frame the main thread tops
+// the ring up by calling web_audio_render for however many frames it is
+// short (see web/index.html and web/audio-worklet.js). A heavy frame then
+// only drains the ring a little further instead of glitching the output,
+// as SDL's main-thread audio callback would.
+
+#include "../engine/audio.h"
+#include <emscripten.h>
+
+#define WEB_AUDIO_MAX_FRAMES 4096
+
+static float web_audio_buffer[WEB_AUDIO_MAX_FRAMES * AUDIO_CHANNELS];
+
+// Called once the page's AudioContext exists, with its sample rate
+EMSCRIPTEN_KEEPALIVE void web_audio_start(int sample_rate) {
+    audio_init(sample_rate);
+}
+
+// Mixes up to WEB_AUDIO_MAX_FRAMES interleaved stereo frames and returns
+// where they are; the page copies them into the ring
+EMSCRIPTEN_KEEPALIVE float* web_audio_render(int frames) {
+    if (frames > WEB_AUDIO_MAX_FRAMES) {
+        frames = WEB_AUDIO_MAX_FRAMES;
+    }
+    audio_mix(web_audio_buffer, frames < 0 ? 0 : frames);
+    return web_audio_buffer;
+}
+
+// Tops the ring up once per frame
+void web_audio_pump(void) {
+    EM_ASM({
+        if (Module.pumpAudio) {
+            Module.pumpAudio();
+        }
+    });
+}
+
+#endif // __EMSCRIPTEN__
\ No newline at end of file
@@ -0,0 +1,37 @@
+// Unity build (zig build -Dunity=true): every engine and platform source in
+// one translation unit, so the compiler can inline across modules, most of
+// all the graphics_* wrappers into the backend's platform_graphics_* calls.
+// Only the backend selected by GRAPHICS_BACKEND_* compiles; main.c and the
+// bench tool stay separate and link against this.
+//
+// Sources that need feature macros must get them here, before any system
+// header is included.
+
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+#define _GNU_SOURCE
+#elif !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L  // startup.c, including the Emscripten build
+#endif
+
+#include "engine/graphics.c"
+#include "engine/ui.c"
+#include "engine/animation.c"
+#include "engine/tilemap.c"
+#include "engine/debug_draw.c"
+#include "engine/camera.c"
+#include "engine/origin.c"
+#include "engine/arena.c"
+#include "engine/hashmap.c"
+#include "engine/intern.c"
+#include "engine/perf.c"
+#include "engine/mem.c"
+#include "engine/simd.c"
+#include "engine/startup.c"
+#include "engine/input.c"
+#include "engine/audio.c"
+#include "engine/loader.c"
+
+#include "platform/null_impl.c"
+#include "platform/raylib_impl.c"
+#include "platform/sdl3_impl.c"
+#include "platform/web_audio.c"
\ No newline at end of file
@@ -0,0 +1,80 @@
+// Plays the wasm mixer's output on the audio rendering thread. Interleaved
+// stereo float frames come through a ring buffer: with a SharedArrayBuffer
+// the main thread writes straight into it, otherwise (page not
+// cross-origin isolated) it posts chunks that are copied in here, and
+// every few render quanta this reports back how full the ring is, since
+// the main thread can't read the indices.
+//
+// Ring layout: header = Int32Array [write index, read index], counting
+// frames and wrapping at 2^32; data = Float32Array of capacity * 2 samples.
+// The capacity is a power of two.
+
+class RingBufferPlayer extends AudioWorkletProcessor {
+    constructor(options) {
+        super();
+        const config = options.processorOptions;
+        this.capacity = config.capacity;
+        this.mask = config.capacity - 1;
+        this.underruns = 0;
+
+        if (config.header && config.data) {
+            this.header = new Int32Array(config.header);
+            this.data = new Float32Array(config.data);
+        } else {
+            this.header = new Int32Array(2);
+            this.data = new Float32Array(config.capacity * 2);
+            this.received = 0;  // frames posted to us, dropped ones included
+            this.quanta = 0;
+            this.port.onmessage = (event) => this.write(event.data);
+        }
+    }
+
+    // Message mode only: append a chunk, dropping what doesn't fit
+    write(samples) {
+        this.received += samples.length / 2;
+        const write = this.header[0];
+        const free = this.capacity - ((write - this.header[1]) | 0);
+        const frames = Math.min(samples.length / 2, free);
+        for (let i = 0; i < frames; i++) {
+            const j = ((write + i) & this.mask) * 2;
+            this.data[j] = samples[i * 2];
+            this.data[j + 1] = samples[i * 2 + 1];
+        }
+        this.header[0] = (write + frames) | 0;
+    }
+
+    process(inputs, outputs) {
+        const left = outputs[0][0];
+        const right = outputs[0][1] || left;
+        const write = Atomics.load(this.header, 0);
+        const read = Atomics.load(this.header, 1);
+        const frames = Math.min((write - read) | 0, left.length);
+
+        for (let i = 0; i < frames; i++) {
+            const j = ((read + i) & this.mask) * 2;
+            left[i] = this.data[j];
+            right[i] = this.data[j + 1];
+        }
+        if (frames < left.length) {
+            // Main thread fell behind by more than the whole ring
+            left.fill(0, frames);
+            right.fill(0, frames);
+            this.underruns++;
+        }
+        Atomics.store(this.header, 1, (read + frames) | 0);
+
+        // Message mode: queued frames as of the end of this quantum, and how
+        // many posted frames that counts, so chunks still in flight and
+        // played silence don't skew the main thread's estimate
+        if (this.received !== undefined && (++this.quanta & 3) === 0) {
+            this.port.postMessage({
+                queued: (write - read - frames) | 0,
+                received: this.received,
+                frame: currentFrame + left.length,
+            });
+        }
+        return true;
+    }
+}
+
+registerProcessor('ring-buffer-player', RingBufferPlayer);
\ No newline at end of file
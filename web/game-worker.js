@@ -0,0 +1,165 @@
+// Experimental, not yet run against a real SDL3 build and not installed by
+// zig build release.
+//
+// Runs the whole wasm game in a dedicated worker for web/worker.html. The
+// page transfers its canvas as an OffscreenCanvas, so SDL renders with
+// WebGL from here and page layout, UI and other main-thread work can't
+// delay a frame. The page has no way to reach SDL's DOM event handlers
+// from here, so it forwards input through an InputRing (input-ring.js)
+// that the SDL3 backend drains at the start of each frame
+// (Module.pumpInput).
+//
+// Messages from the page:
+//   {type: 'start', canvas, capacity, header, records}  header/records are
+//       the shared input ring, or null to receive 'input' messages instead
+//   {type: 'input', event: [kind, code, id, x, y, time]}
+//   {type: 'audio', sampleRate, capacity, target, minRender, header, data}
+//       the AudioWorklet's shared ring (web/audio-worklet.js)
+// Messages to the page: {type: 'status', text, state} and
+// {type: 'log', text, error}.
+
+importScripts('input-ring.js');
+
+var Module;
+let input = null;
+let audio = null;
+let running = false;
+
+function post(message) {
+    self.postMessage(message);
+}
+
+function pumpInput() {
+    const now = performance.timeOrigin + performance.now();
+    input.drain(function(kind, code, id, x, y, time) {
+        if (kind === INPUT_KIND_KEY) {
+            Module._web_key_event(code, id, now - time);
+        } else {
+            Module._web_pointer_event(code, id, x, y, now - time);
+        }
+    });
+}
+
+// Same top-up as index.html's SharedArrayBuffer path: mix however many
+// frames the ring is short of the target
+function pumpAudio() {
+    if (!audio) {
+        return;
+    }
+    const queued = (Atomics.load(audio.header, 0) - Atomics.load(audio.header, 1)) | 0;
+    const frames = audio.target - queued;
+    if (frames < audio.minRender) {
+        return;
+    }
+
+    const pointer = Module._web_audio_render(frames) >> 2;
+    const samples = Module.HEAPF32.subarray(pointer, pointer + frames * 2);
+    const write = audio.header[0];
+    for (let i = 0; i < frames; i++) {
+        const j = ((write + i) & (audio.capacity - 1)) * 2;
+        audio.data[j] = samples[i * 2];
+        audio.data[j + 1] = samples[i * 2 + 1];
+    }
+    Atomics.store(audio.header, 0, (write + frames) | 0);
+}
+
+// SDL's Emscripten video driver expects a page: it measures the canvas
+// (getBoundingClientRect), sets its CSS size and cursor (style), looks it
+// up with document.querySelector and adds listeners to document and
+// window. An OffscreenCanvas has no layout and a worker has no DOM, so
+// stand in for just those. The CSS size reports the backing size, which
+// SDL reads as "not sized by the page" and leaves alone. Installed from
+// preRun, after Emscripten has detected it runs in a worker.
+function provideDom(canvas) {
+    const noop = function() {};
+    canvas.style = {};
+    canvas.getBoundingClientRect = function() {
+        return {
+            x: 0, y: 0, left: 0, top: 0,
+            right: canvas.width, bottom: canvas.height,
+            width: canvas.width, height: canvas.height,
+        };
+    };
+    self.document = {
+        querySelector: function(selector) {
+            return selector === '#canvas' ? canvas : null;
+        },
+        getElementById: function(id) {
+            return id === 'canvas' ? canvas : null;
+        },
+        addEventListener: noop,
+        removeEventListener: noop,
+        hidden: false,
+        visibilityState: 'visible',
+        fullscreenElement: null,
+    };
+    // Listeners on the worker scope never fire, which is what SDL gets
+    // for resize and focus here anyway
+    self.window = self;
+}
+
+function start(message) {
+    const canvas = message.canvas;
+    input = message.header
+        ? new InputRing(message.capacity, message.header, message.records)
+        : InputRing.create(message.capacity, false);
+
+    Module = {
+        print: function(text) {
+            post({ type: 'log', text: text, error: false });
+        },
+        printErr: function(text) {
+            post({ type: 'log', text: text, error: true });
+        },
+        canvas: canvas,
+        pumpInput: pumpInput,
+        pumpAudio: pumpAudio,
+        // No document to look "#canvas" up in, so point Emscripten's HTML5
+        // and WebGL lookups at the transferred canvas
+        preRun: [function() {
+            Module.specialHTMLTargets['#canvas'] = canvas;
+            provideDom(canvas);
+        }],
+        setStatus: function(text) {
+            if (text) {
+                post({ type: 'status', text: text, state: 'loading' });
+            }
+        },
+        onAbort: function(what) {
+            post({ type: 'status', text: 'Failed to load WebAssembly module: ' + what, state: 'error' });
+        },
+        onRuntimeInitialized: function() {
+            running = true;
+            if (audio) {
+                Module._web_audio_start(audio.sampleRate);
+            }
+            post({ type: 'status', text: 'Game initialized - Running in a worker!', state: 'ready' });
+        },
+    };
+    importScripts('game.js');
+}
+
+self.onmessage = function(event) {
+    const message = event.data;
+    switch (message.type) {
+        case 'start':
+            start(message);
+            break;
+        case 'input':
+            input.push.apply(input, message.event);
+            break;
+        case 'audio':
+            audio = {
+                sampleRate: message.sampleRate,
+                capacity: message.capacity,
+                target: message.target,
+                minRender: message.minRender,
+                header: new Int32Array(message.header),
+                data: new Float32Array(message.data),
+            };
+            if (running) {
+                Module._web_audio_start(audio.sampleRate);
+            }
+            break;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,67 @@
+// Input events from web/worker.html to the game running in
+// web/game-worker.js. One producer (the page), one consumer (the worker,
+// once per frame). With a SharedArrayBuffer the page writes straight into
+// the worker's ring; otherwise (page not cross-origin isolated) each event
+// is posted and the worker pushes it into a local ring.
+//
+// Layout: header = Int32Array [write index, read index, dropped], indices
+// count events and wrap at 2^32; records = Float64Array of capacity *
+// INPUT_RING_FIELDS: kind, code, id, x, y, time. Times are milliseconds
+// since the epoch (performance.timeOrigin + timeStamp), which the page and
+// the worker agree on while their performance.now() origins differ.
+// The capacity is a power of two.
+
+const INPUT_RING_FIELDS = 6;
+const INPUT_KIND_KEY = 0;      // code = SDL keycode, id = 1 down / 0 up
+const INPUT_KIND_POINTER = 1;  // code = pointer phase, id = pointer id
+
+class InputRing {
+    constructor(capacity, header, records) {
+        this.capacity = capacity;
+        this.mask = capacity - 1;
+        this.header = new Int32Array(header);
+        this.records = new Float64Array(records);
+    }
+
+    static create(capacity, shared) {
+        const Buffer = shared ? SharedArrayBuffer : ArrayBuffer;
+        return new InputRing(capacity,
+            new Buffer(3 * Int32Array.BYTES_PER_ELEMENT),
+            new Buffer(capacity * INPUT_RING_FIELDS * Float64Array.BYTES_PER_ELEMENT));
+    }
+
+    // Drops the event when the consumer is a whole ring behind
+    push(kind, code, id, x, y, time) {
+        const write = Atomics.load(this.header, 0);
+        if (((write - Atomics.load(this.header, 1)) | 0) >= this.capacity) {
+            Atomics.add(this.header, 2, 1);
+            return false;
+        }
+        const j = (write & this.mask) * INPUT_RING_FIELDS;
+        this.records[j] = kind;
+        this.records[j + 1] = code;
+        this.records[j + 2] = id;
+        this.records[j + 3] = x;
+        this.records[j + 4] = y;
+        this.records[j + 5] = time;
+        Atomics.store(this.header, 0, (write + 1) | 0);
+        return true;
+    }
+
+    // Calls handler(kind, code, id, x, y, time) for each queued event, oldest first
+    drain(handler) {
+        const write = Atomics.load(this.header, 0);
+        let read = Atomics.load(this.header, 1);
+        while (read !== write) {
+            const j = (read & this.mask) * INPUT_RING_FIELDS;
+            const r = this.records;
+            handler(r[j], r[j + 1], r[j + 2], r[j + 3], r[j + 4], r[j + 5]);
+            read = (read + 1) | 0;
+        }
+        Atomics.store(this.header, 1, read);
+    }
+
+    dropped() {
+        return Atomics.load(this.header, 2);
+    }
+}
\ No newline at end of file